@@ -0,0 +1,98 @@
+"""
+Deterministic reference corpus for the benchmark suite.
+
+The images are generated parametrically (no randomness, no binary files
+checked into the repository) so every machine benchmarks exactly the
+same inputs. Three size/complexity classes are covered:
+
+- simple filled shapes (circle, star): short contours, the common case;
+- a donut: a shape with a hole, exercising hierarchical contours;
+- a dense 8K-class spiral: a very long contour on a 7680x4320 canvas,
+  the stress case for discretization, filtering and drawing.
+"""
+
+import os
+
+import cv2
+import numpy as np
+
+CORPUS_DIRECTORY = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                "corpus")
+
+
+def _blank_canvas(width, height):
+    return np.full((height, width, 3), 255, dtype=np.uint8)
+
+
+def _generate_circle(path):
+    image = _blank_canvas(1024, 1024)
+    cv2.circle(image, (512, 512), 380, (0, 0, 0), -1)
+    cv2.imwrite(path, image)
+
+
+def _generate_star(path):
+    image = _blank_canvas(1024, 1024)
+    points = []
+    for index in range(14):
+        angle = index * np.pi / 7.0 - np.pi / 2.0
+        radius = 420 if index % 2 == 0 else 180
+        points.append((512 + radius * np.cos(angle),
+                       512 + radius * np.sin(angle)))
+    cv2.fillPoly(image, [np.array(points, dtype=np.int32)], (0, 0, 0))
+    cv2.imwrite(path, image)
+
+
+def _generate_donut(path):
+    image = _blank_canvas(1024, 1024)
+    cv2.circle(image, (512, 512), 400, (0, 0, 0), -1)
+    cv2.circle(image, (512, 512), 200, (255, 255, 255), -1)
+    cv2.imwrite(path, image)
+
+
+def _generate_dense_spiral(path):
+    # 8K-class canvas with an Archimedean spiral drawn as a thick
+    # polyline: one very long contour with tens of thousands of vertices
+    width, height = 7680, 4320
+    image = _blank_canvas(width, height)
+    turns = 18
+    angles = np.linspace(0.0, turns * 2.0 * np.pi, 40000)
+    radii = 40.0 + angles * (2000.0 / (turns * 2.0 * np.pi))
+    xs = width / 2.0 + radii * np.cos(angles)
+    ys = height / 2.0 + radii * np.sin(angles) * (4320.0 / 7680.0 * 1.6)
+    points = np.stack([xs, ys], axis=1).astype(np.int32)
+    cv2.polylines(image, [points], False, (0, 0, 0), thickness=24)
+    cv2.imwrite(path, image)
+
+
+# name -> (generator, shape detection mode best suited to the input)
+CORPUS_IMAGES = {
+    "simple_circle": (_generate_circle, "contour"),
+    "star": (_generate_star, "contour"),
+    "donut": (_generate_donut, "contour"),
+    "dense_spiral_8k": (_generate_dense_spiral, "path"),
+}
+
+
+def ensure_corpus(directory=None):
+    """
+    Generates any missing corpus image and returns the corpus as a dict
+    mapping image name to (image path, shape detection mode).
+
+    Parameters:
+    - directory: Destination directory. Defaults to benchmarks/corpus.
+
+    Returns:
+    - dict: name -> (path, shape_detection).
+    """
+    if directory is None:
+        directory = CORPUS_DIRECTORY
+    os.makedirs(directory, exist_ok=True)
+
+    corpus = {}
+    for name, (generator, shape_detection) in CORPUS_IMAGES.items():
+        path = os.path.join(directory, f"{name}.png")
+        if not os.path.isfile(path):
+            print(f"Generating corpus image {path}...")
+            generator(path)
+        corpus[name] = (path, shape_detection)
+    return corpus
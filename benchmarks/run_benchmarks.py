@@ -0,0 +1,256 @@
+"""
+Benchmark suite for the dot-to-dot processing pipeline.
+
+Each pipeline stage is benchmarked in isolation (discretization, dot
+selection, overlap detection, drawing) plus the full
+`process_single_image` path, over the generated reference corpus (see
+corpus.py). Timings are the minimum over a few repeats, written as JSON
+under benchmarks/results/, and compared against benchmarks/baseline.json
+when it exists so performance regressions are caught before release.
+
+Usage, from the repository root:
+
+    python benchmarks/run_benchmarks.py                  # run and compare
+    python benchmarks/run_benchmarks.py --update-baseline
+    python benchmarks/run_benchmarks.py --skip-dense     # skip the 8K input
+
+The script exits with a non-zero status when any stage is slower than
+the baseline by more than the tolerance (default: 25%).
+"""
+
+import argparse
+import json
+import os
+import platform
+import sys
+import time
+
+sys.path.insert(
+    0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+import cv2
+
+import corpus
+from dot2dot.dots_config import DotsConfig
+from dot2dot.dots_selection import DotsSelection
+from dot2dot.grid_dots import GridDots
+from dot2dot.image_creation import ImageCreation
+from dot2dot.image_discretization import ImageDiscretization
+from dot2dot.load_config import LoadConfig
+from dot2dot.processing import process_single_image
+
+BENCHMARK_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+BASELINE_PATH = os.path.join(BENCHMARK_DIRECTORY, "baseline.json")
+RESULTS_DIRECTORY = os.path.join(BENCHMARK_DIRECTORY, "results")
+
+
+def time_callable(func, repeats):
+    """
+    Runs `func` `repeats` times and returns (best seconds, last result).
+    The minimum is the least noisy statistic for regression detection.
+    """
+    best = None
+    result = None
+    for _ in range(repeats):
+        start = time.perf_counter()
+        result = func()
+        elapsed = time.perf_counter() - start
+        if best is None or elapsed < best:
+            best = elapsed
+    return best, result
+
+
+def benchmark_image(name, image_path, shape_detection, dots_config, repeats):
+    """
+    Benchmarks every stage on one corpus image.
+
+    Returns:
+    - dict: stage name -> {"seconds": float, ...stage metadata}.
+    """
+    print(f"Benchmarking {name} ({shape_detection} mode)...")
+    dots_config.input_path = image_path
+    dots_config.shape_detection = shape_detection
+
+    image = cv2.imread(image_path)
+    image_height, image_width = image.shape[:2]
+    stages = {}
+
+    # Stage 1: discretization. The uncached path is measured on purpose:
+    # the persistent discretization cache would turn every repeat after
+    # the first into a disk read of the previous result. The instance is
+    # built once (its constructor is a plain imread, not part of the
+    # stage), but its preprocessing cache is cleared per repeat so each
+    # one pays the full grayscale/threshold/morphology cost.
+    image_discretization = ImageDiscretization(image_path, shape_detection,
+                                               dots_config.threshold_binary,
+                                               False)
+
+    def run_discretization():
+        image_discretization._preprocess_cache = None
+        image_discretization._preprocess_cache_key = None
+        return image_discretization._discretize_image_uncached()
+
+    seconds, dots = time_callable(run_discretization, repeats)
+    stages["discretize_image"] = {
+        "seconds": seconds,
+        "input_pixels": image_width * image_height,
+        "num_points": len(dots),
+    }
+
+    # Stage 2: dot selection. A fresh DotsSelection is built inside the
+    # timed callable because contour_to_linear_paths reorders its input.
+    def run_selection():
+        dots_selection = DotsSelection(
+            epsilon_factor=dots_config.epsilon,
+            max_distance=dots_config.distance_max,
+            min_distance=dots_config.distance_min,
+            dots=list(dots),
+            debug=False)
+        return dots_selection.contour_to_linear_paths()
+
+    seconds, selected_dots = time_callable(run_selection, repeats)
+    stages["contour_to_linear_paths"] = {
+        "seconds": seconds,
+        "num_points": len(dots),
+        "num_dots": len(selected_dots),
+    }
+
+    # Stage 3: drawing. ImageCreation positions the labels, so it also
+    # produces the dot set used by the overlap benchmark below.
+    def run_draw():
+        image_creation = ImageCreation(
+            image_size=(image_height, image_width),
+            dots=selected_dots,
+            dot_control=dots_config.dot_control,
+            debug=False)
+        return image_creation.draw_points_on_image(image_path)
+
+    seconds, (_, updated_dots, _) = time_callable(run_draw, repeats)
+    stages["draw_points_on_image"] = {
+        "seconds": seconds,
+        "num_dots": len(updated_dots),
+    }
+
+    # Stage 4: overlap detection, including grid population since the
+    # grid only exists to answer overlap queries.
+    def run_overlaps():
+        grid = GridDots(image_width, image_height, 80, updated_dots)
+        return grid.find_all_overlaps()
+
+    seconds, _ = time_callable(run_overlaps, repeats)
+    stages["find_all_overlaps"] = {
+        "seconds": seconds,
+        "num_dots": len(updated_dots),
+    }
+
+    # End to end. Repeats after the first hit the discretization cache,
+    # which keeps the measurement stable across runs of this script.
+    seconds, _ = time_callable(lambda: process_single_image(dots_config),
+                               repeats)
+    stages["process_single_image"] = {
+        "seconds": seconds,
+        "input_pixels": image_width * image_height,
+    }
+
+    for stage_name, stage in stages.items():
+        print(f"  {stage_name}: {stage['seconds'] * 1000.0:.1f} ms")
+    return stages
+
+
+def compare_with_baseline(results, baseline, tolerance):
+    """
+    Compares benchmark results against a baseline.
+
+    Returns:
+    - list of str: one message per stage slower than baseline by more
+      than `tolerance` (fraction, e.g. 0.25 for 25%).
+    """
+    regressions = []
+    for image_name, stages in results.items():
+        baseline_stages = baseline.get(image_name, {})
+        for stage_name, stage in stages.items():
+            reference = baseline_stages.get(stage_name)
+            if not reference:
+                continue
+            allowed = reference["seconds"] * (1.0 + tolerance)
+            if stage["seconds"] > allowed:
+                regressions.append(
+                    f"{image_name}/{stage_name}: "
+                    f"{stage['seconds'] * 1000.0:.1f} ms vs baseline "
+                    f"{reference['seconds'] * 1000.0:.1f} ms "
+                    f"(+{tolerance * 100.0:.0f}% allowed)")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark the dot-to-dot pipeline over the reference "
+        "corpus and compare against the stored baseline.")
+    parser.add_argument('--repeats',
+                        type=int,
+                        default=3,
+                        help='Repeats per stage; the best time is kept '
+                        '(default: 3).')
+    parser.add_argument('--tolerance',
+                        type=float,
+                        default=0.25,
+                        help='Allowed slowdown over baseline before a stage '
+                        'is reported as a regression (default: 0.25).')
+    parser.add_argument('--update-baseline',
+                        action='store_true',
+                        help='Write the results as the new baseline.')
+    parser.add_argument('--skip-dense',
+                        action='store_true',
+                        help='Skip the 8K-class input for quick runs.')
+    args = parser.parse_args()
+
+    config = LoadConfig()
+    dots_config = DotsConfig.default_dots_config(config)
+
+    results = {}
+    for name, (image_path,
+               shape_detection) in corpus.ensure_corpus().items():
+        if args.skip_dense and "8k" in name:
+            continue
+        results[name] = benchmark_image(name, image_path, shape_detection,
+                                        dots_config, args.repeats)
+
+    os.makedirs(RESULTS_DIRECTORY, exist_ok=True)
+    report = {
+        "timestamp": time.strftime("%Y-%m-%d %H:%M:%S"),
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "repeats": args.repeats,
+        "results": results,
+    }
+    results_path = os.path.join(
+        RESULTS_DIRECTORY,
+        time.strftime("benchmark_%Y%m%d_%H%M%S.json"))
+    with open(results_path, "w", encoding="utf-8") as file:
+        json.dump(report, file, indent=4)
+    print(f"Results written to {results_path}")
+
+    if args.update_baseline:
+        with open(BASELINE_PATH, "w", encoding="utf-8") as file:
+            json.dump(results, file, indent=4)
+        print(f"Baseline updated at {BASELINE_PATH}")
+        return 0
+
+    if not os.path.isfile(BASELINE_PATH):
+        print("No baseline found; run with --update-baseline to create one.")
+        return 0
+
+    with open(BASELINE_PATH, "r", encoding="utf-8") as file:
+        baseline = json.load(file)
+    regressions = compare_with_baseline(results, baseline, args.tolerance)
+    if regressions:
+        print("Performance regressions detected:")
+        for message in regressions:
+            print(f"- {message}")
+        return 1
+    print("No regression against the baseline.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
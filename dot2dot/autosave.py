@@ -0,0 +1,296 @@
+"""
+Asynchronous incremental autosave.
+
+A single background writer keeps a crash-recovery copy of the current
+puzzle under the config directory. Full snapshots go through the
+columnar binary .d2d container (whose dot columns are built from a
+DotCollection), and the dot-level edits made between snapshots
+are appended to a small JSON-lines journal, so recording a change from
+the GUI only queues a dict and never blocks editing. The journal is
+compacted into the next snapshot whenever the applied state absorbs the
+edits, and an `autosave.active` marker distinguishes a crash from a
+clean shutdown so recovery can be offered on the next start.
+"""
+
+import json
+import os
+import threading
+import time
+
+from dot2dot import d2d_format
+from dot2dot.dot import Dot
+from dot2dot.utils import get_base_directory
+
+SNAPSHOT_NAME = "autosave.d2d"
+JOURNAL_NAME = "autosave.journal"
+MARKER_NAME = "autosave.active"
+
+
+def get_autosave_directory():
+    """
+    Returns the autosave directory under the config directory, creating
+    it if needed.
+    """
+    base_directory = get_base_directory()
+    autosave_directory = os.path.join(base_directory, 'assets', 'config',
+                                      'autosave')
+    if not os.path.exists(autosave_directory):
+        os.makedirs(autosave_directory)
+    return autosave_directory
+
+
+def _remove_quietly(file_path):
+    try:
+        os.remove(file_path)
+    except OSError:
+        pass
+
+
+def _read_journal(journal_path):
+    """
+    Reads the JSON-lines journal, skipping malformed lines (typically a
+    line truncated by the crash itself).
+    """
+    entries = []
+    try:
+        with open(journal_path, "r") as journal:
+            for line in journal:
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    entries.append(json.loads(line))
+                except json.JSONDecodeError:
+                    continue
+    except OSError:
+        pass
+    return entries
+
+
+def _renumber_from(dots, start_index):
+    for index in range(start_index, len(dots)):
+        dots[index].dot_id = index + 1
+
+
+def _apply_journal_entry(dots, entry, dots_config_data):
+    """
+    Replays one dot-level journal entry onto the snapshot dots.
+    """
+    op = entry.get("op")
+    if op == "move":
+        index = int(entry["dot_id"]) - 1
+        if not 0 <= index < len(dots):
+            return
+        dot = dots[index]
+        if entry.get("position") is not None:
+            dot.position = tuple(entry["position"])
+        if dot.label is not None and entry.get("label_position") is not None:
+            dot.label.position = tuple(entry["label_position"])
+    elif op == "delete":
+        index = int(entry["dot_id"]) - 1
+        if not 0 <= index < len(dots):
+            return
+        del dots[index]
+        _renumber_from(dots, index)
+    elif op == "insert":
+        index = max(0, min(len(dots), int(entry["dot_id"]) - 1))
+        dot = Dot(tuple(entry["position"]), index + 1)
+        dot_control_data = dots_config_data.get("dot_control", {})
+        if dot_control_data.get("radius") is not None:
+            dot.radius = dot_control_data["radius"]
+        if dot_control_data.get("color") is not None:
+            dot.color = tuple(dot_control_data["color"])
+        label_data = dot_control_data.get("label")
+        if label_data:
+            dot.set_label(tuple(label_data["color"]),
+                          label_data["font_path"],
+                          int(label_data["font_size"]))
+            if entry.get("label_position") is not None:
+                dot.label.position = tuple(entry["label_position"])
+            dot.label.anchor = label_data.get("anchor", "ls")
+        dots.insert(index, dot)
+        _renumber_from(dots, index + 1)
+    elif op == "radius":
+        for dot in dots:
+            dot.radius = entry["value"]
+    elif op == "font_size":
+        for dot in dots:
+            if dot.label is not None:
+                # Rebuild the label so the PIL font matches the new size
+                position = dot.label.position
+                anchor = dot.label.anchor
+                dot.set_label(tuple(dot.label.color), dot.label.font_path,
+                              int(entry["value"]))
+                dot.label.position = position
+                dot.label.anchor = anchor
+    elif op == "reverse":
+        dots.reverse()
+        _renumber_from(dots, 0)
+
+
+def pending_recovery_path(directory=None):
+    """
+    Checks for an unclean shutdown and, if one is found, compacts the
+    last snapshot plus its journal into a loadable .d2d file.
+
+    Returns:
+        str or None: Path of the recovered autosave file, or None when
+                     the previous session ended cleanly.
+    """
+    directory = directory or get_autosave_directory()
+    marker_path = os.path.join(directory, MARKER_NAME)
+    snapshot_path = os.path.join(directory, SNAPSHOT_NAME)
+    journal_path = os.path.join(directory, JOURNAL_NAME)
+    if not os.path.exists(marker_path):
+        return None
+    # The marker is consumed either way so a failed or declined
+    # recovery is not offered again on every start
+    _remove_quietly(marker_path)
+    if not os.path.exists(snapshot_path):
+        _remove_quietly(journal_path)
+        return None
+    try:
+        binary_file = d2d_format.D2DBinaryFile(snapshot_path)
+        entries = _read_journal(journal_path)
+        if entries:
+            dots = binary_file.to_dots()
+            for entry in entries:
+                _apply_journal_entry(dots, entry,
+                                     binary_file.dots_config_data)
+            # Release the column mappings before touching the snapshot
+            # (Windows refuses to replace a file that is still mapped),
+            # and compact through a temp file like _write_snapshot so a
+            # failure here cannot corrupt the only recovery copy
+            binary_file.close()
+            temp_path = snapshot_path + ".tmp"
+            d2d_format.write_binary_d2d(temp_path, dots,
+                                        binary_file.dots_config_data,
+                                        binary_file.metadata)
+            os.replace(temp_path, snapshot_path)
+    except Exception as error:
+        print(f"Autosave recovery failed: {error}")
+        return None
+    _remove_quietly(journal_path)
+    return snapshot_path
+
+
+class AutosaveService:
+    """
+    Background writer owning the snapshot and journal files. The GUI
+    thread only queues journal entries (`record_change`) or requests a
+    snapshot (`mark_dirty`); all disk writes happen on one daemon
+    thread.
+    """
+
+    def __init__(self, get_state, directory=None, snapshot_interval=5.0):
+        """
+        Parameters:
+        - get_state: Callable returning (dots, dots_config_data,
+          metadata) for the next snapshot, or None when there is
+          nothing to save yet. Called on the writer thread.
+        - directory: Autosave directory, defaults to the config one.
+        - snapshot_interval: Minimum seconds between two snapshots.
+        """
+        self.get_state = get_state
+        self.directory = directory or get_autosave_directory()
+        self.snapshot_interval = snapshot_interval
+        self.snapshot_path = os.path.join(self.directory, SNAPSHOT_NAME)
+        self.journal_path = os.path.join(self.directory, JOURNAL_NAME)
+        self.marker_path = os.path.join(self.directory, MARKER_NAME)
+        self._condition = threading.Condition()
+        self._queue = []
+        self._dirty = False
+        self._stopped = False
+        self._last_snapshot_time = 0.0
+        self._worker = threading.Thread(target=self._run,
+                                        name="autosave-writer",
+                                        daemon=True)
+        self._worker.start()
+
+    def record_change(self, entry):
+        """
+        Queues one dot-level journal entry (see _apply_journal_entry for
+        the supported operations) and returns immediately.
+        """
+        with self._condition:
+            self._queue.append(entry)
+            self._condition.notify()
+
+    def mark_dirty(self):
+        """
+        Requests a full snapshot: the applied state now supersedes the
+        journal, which is truncated once the snapshot is on disk.
+        """
+        with self._condition:
+            self._dirty = True
+            self._condition.notify()
+
+    def shutdown(self):
+        """
+        Flushes a final snapshot if needed and marks the shutdown clean
+        so no recovery is offered on the next start.
+        """
+        with self._condition:
+            self._stopped = True
+            self._condition.notify()
+        self._worker.join(timeout=10.0)
+        _remove_quietly(self.marker_path)
+
+    def _snapshot_due(self):
+        return time.time() - self._last_snapshot_time >= self.snapshot_interval
+
+    def _ensure_marker(self):
+        if not os.path.exists(self.marker_path):
+            with open(self.marker_path, "w") as marker:
+                marker.write(str(os.getpid()))
+
+    def _append_journal(self, entries):
+        try:
+            self._ensure_marker()
+            with open(self.journal_path, "a") as journal:
+                for entry in entries:
+                    # default=float flattens stray numpy scalars coming
+                    # from the GUI coordinates
+                    journal.write(json.dumps(entry, default=float))
+                    journal.write("\n")
+                journal.flush()
+        except Exception as error:
+            print(f"Autosave journal write failed: {error}")
+
+    def _write_snapshot(self):
+        try:
+            state = self.get_state()
+            if state is None:
+                return
+            dots, dots_config_data, metadata = state
+            self._ensure_marker()
+            temp_path = self.snapshot_path + ".tmp"
+            d2d_format.write_binary_d2d(temp_path, dots, dots_config_data,
+                                        metadata)
+            os.replace(temp_path, self.snapshot_path)
+            # The snapshot absorbed everything journaled so far
+            with open(self.journal_path, "w"):
+                pass
+            self._last_snapshot_time = time.time()
+        except Exception as error:
+            print(f"Autosave snapshot failed: {error}")
+
+    def _run(self):
+        while True:
+            with self._condition:
+                while (not self._stopped and not self._queue
+                       and not (self._dirty and self._snapshot_due())):
+                    self._condition.wait(timeout=1.0)
+                entries = self._queue
+                self._queue = []
+                stopped = self._stopped
+                snapshot_needed = self._dirty and (stopped
+                                                   or self._snapshot_due())
+                if snapshot_needed:
+                    self._dirty = False
+            if entries:
+                self._append_journal(entries)
+            if snapshot_needed:
+                self._write_snapshot()
+            if stopped:
+                return
@@ -0,0 +1,110 @@
+"""
+Dependency-free utility functions.
+
+These helpers only need the standard library, so the startup path
+(argument parsing and configuration loading in main.py) can import them
+without paying the multi-second cv2/PIL/numpy import cost. The heavy
+image helpers stay in dot2dot.utils, which re-exports everything here
+for existing call sites.
+"""
+import os
+import sys
+from argparse import ArgumentTypeError
+
+
+def str_color_to_tuple(color_str):
+    split_str = color_str.split(',')
+    if split_str == ['']:
+        return tuple()
+    color_list = []
+    for s in split_str:
+        s_int = str_to_int_safe(s)
+        if s_int is None:
+            return tuple()
+        color_list.append(s_int)
+    return tuple(color_list)
+
+
+def str_to_int_safe(str_to_convert):
+    if str_to_convert != '':
+        return int(str_to_convert)
+    else:
+        return None
+
+
+def get_base_directory():
+    """
+    Determines the base directory for the application, depending on whether it's run
+    as a standalone executable via PyInstaller or cx_Freeze, or as a normal Python script.
+
+    - PyInstaller sets sys._MEIPASS when frozen.
+    - cx_Freeze sets sys.frozen = True but does not provide sys._MEIPASS.
+      Instead, the executable directory (os.path.dirname(sys.executable)) can be used.
+
+    If not frozen at all, we return the parent directory of the current file.
+    """
+    if getattr(sys, 'frozen', False):
+        return os.path.dirname(sys.executable)
+    else:
+        # Running normally as a script
+        current_directory = os.path.abspath(os.path.dirname(__file__))
+        return os.path.abspath(os.path.join(current_directory, os.pardir))
+
+
+def rgba_to_hex(rgba):
+    """
+    Converts an RGBA string or tuple to a hexadecimal color code.
+    Ignores the alpha channel.
+
+    Parameters:
+    - rgba: String representing RGBA values separated by commas or a tuple of (R, G, B, A).
+
+    Returns:
+    - Hexadecimal color code string.
+    """
+    try:
+        if isinstance(rgba, str):
+            parts = rgba.split(',')
+            if len(parts) != 4:
+                raise ValueError(
+                    "RGBA string must have exactly four components.")
+            r, g, b, _ = [int(part.strip()) for part in parts]
+        elif isinstance(rgba, tuple) and len(rgba) == 4:
+            r, g, b, _ = rgba
+        else:
+            raise ValueError(
+                "RGBA must be a string or a tuple of four components.")
+
+        return f'#{r:02X}{g:02X}{b:02X}'
+    except Exception as _:
+        return "#000000"  # Default to black if conversion fails
+
+
+def parse_rgba(rgba_str):
+    """
+    Parses an RGBA string into a list of integers.
+
+    Args:
+        rgba_str (str): A string like "248,208,73,255".
+
+    Returns:
+        list: A list of integers [248, 208, 73, 255].
+    """
+    try:
+        return list(map(int, rgba_str.split(',')))
+    except ValueError:
+        return [0, 0, 0, 255]  # Default to black if parsing fails
+
+
+def str2bool(v):
+    """
+    Converts a string argument to a boolean value.
+    """
+    if isinstance(v, bool):
+        return v
+    if v.lower() in ('yes', 'true', 't', 'y', '1'):
+        return True
+    elif v.lower() in ('no', 'false', 'f', 'n', '0'):
+        return False
+    else:
+        raise ArgumentTypeError('Boolean value expected.')
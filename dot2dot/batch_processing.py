@@ -0,0 +1,136 @@
+"""
+Headless batch processing of a folder of images.
+Fans the images across a persistent multiprocess worker pool so the
+interpreter, fonts and configuration are loaded once per worker instead
+of once per image.
+"""
+import os
+import time
+import multiprocessing
+
+from dot2dot.dots_config import DotsConfig
+from dot2dot.processing import process_single_image
+from dot2dot.utils import generate_output_path, save_image
+
+# Per-worker DotsConfig, built once in _init_worker and reused for every
+# image handled by that worker (fonts are loaded at construction time).
+_worker_dots_config = None
+
+
+def _init_worker(config):
+    """
+    Initializes a worker process: builds the DotsConfig (and therefore
+    loads the font) a single time for the lifetime of the worker.
+
+    Args:
+        config (dict): Plain configuration dictionary, picklable across
+                       process boundaries.
+    """
+    global _worker_dots_config
+    _worker_dots_config = DotsConfig.default_dots_config(config)
+
+
+def _process_one(task):
+    """
+    Processes a single (input_path, output_path) task in a worker and
+    saves the resulting image.
+
+    Returns:
+        tuple: (input_path, elapsed_seconds, success, error_message).
+    """
+    input_path, output_path = task
+    start_time = time.time()
+    try:
+        dots_config = _worker_dots_config
+        dots_config.input_path = input_path
+        dots_config.output_path = output_path
+        result = process_single_image(dots_config)
+        if result is None:
+            return (input_path, time.time() - start_time, False,
+                    "processing returned no result")
+        output_image_with_dots = result[0]
+        save_image(output_image_with_dots, output_path, dots_config.dpi)
+        return (input_path, time.time() - start_time, True, None)
+    except Exception as e:
+        return (input_path, time.time() - start_time, False, str(e))
+
+
+def run_batch(config,
+              input_dir,
+              output_dir=None,
+              jobs=None,
+              label_time_budget=None):
+    """
+    Processes every image of input_dir on a worker pool and streams the
+    results to output_dir, printing per-image timings and a summary.
+
+    Args:
+        config (LoadConfig or dict): Application configuration.
+        input_dir (str): Folder containing the images to process.
+        output_dir (str or None): Destination folder. Defaults to input_dir.
+        jobs (int or None): Number of worker processes. Defaults to the
+                            CPU count.
+        label_time_budget (float or None): Seconds for the extra label
+                            placement pass, overriding the config entry.
+
+    Returns:
+        int: Number of images that failed to process.
+    """
+    if hasattr(config, 'get_config'):
+        config = config.get_config()
+    if label_time_budget is not None:
+        # Forwarded to the workers through their DotsConfig
+        config = dict(config, labelTimeBudget=float(label_time_budget))
+
+    if not os.path.isdir(input_dir):
+        print(f"Error - Batch input {input_dir} is not a folder.")
+        return 1
+
+    if not output_dir:
+        output_dir = input_dir
+    os.makedirs(output_dir, exist_ok=True)
+
+    image_files = sorted(f for f in os.listdir(input_dir)
+                         if f.lower().endswith(('.png', '.jpg', '.jpeg')))
+    if not image_files:
+        print(f"No image found in the folder {input_dir}.")
+        return 0
+
+    tasks = []
+    for image_file in image_files:
+        input_path = os.path.join(input_dir, image_file)
+        output_path = generate_output_path(
+            os.path.join(output_dir, image_file))
+        tasks.append((input_path, output_path))
+
+    jobs = jobs if jobs else multiprocessing.cpu_count()
+    print(f"Processing {len(tasks)} images from {input_dir} "
+          f"with {jobs} worker(s)...")
+
+    start_time = time.time()
+    results = []
+    with multiprocessing.Pool(processes=jobs,
+                              initializer=_init_worker,
+                              initargs=(config, )) as pool:
+        for result in pool.imap_unordered(_process_one, tasks):
+            input_path, elapsed, success, error = result
+            name = os.path.basename(input_path)
+            if success:
+                print(f"  {name}: {elapsed:.2f} s")
+            else:
+                print(f"  {name}: FAILED after {elapsed:.2f} s ({error})")
+            results.append(result)
+
+    total_time = time.time() - start_time
+    failures = [r for r in results if not r[2]]
+    processed = len(results) - len(failures)
+    per_image_times = [r[1] for r in results if r[2]]
+    mean_time = sum(per_image_times) / len(
+        per_image_times) if per_image_times else 0.0
+
+    print(f"Batch complete: {processed}/{len(results)} images in "
+          f"{total_time:.2f} s (mean {mean_time:.2f} s per image).")
+    for input_path, _, _, error in failures:
+        print(f"  Failed: {os.path.basename(input_path)} ({error})")
+
+    return len(failures)
@@ -15,7 +15,8 @@ DEFAULT_CONFIG_CONTENT = {
     "verbose": True,
     "thresholdBinary": [100, 255],
     "gui": True,
-    "screenChoice": 0
+    "screenChoice": 0,
+    "labelTimeBudget": 0.0
 }
 
 CONFIG_SCHEMA = {
@@ -103,6 +104,12 @@ CONFIG_SCHEMA = {
             "type": "integer",
             "minimum": 0,
             "description": "Index of the selected screen"
+        },
+        "labelTimeBudget": {
+            "type": "number",
+            "minimum": 0,
+            "description":
+            "Seconds allowed for the extra label placement pass (0 disables it)"
         }
     },
     "required": [
@@ -0,0 +1,90 @@
+"""
+Persistent cache for discretization results.
+Results are content-addressed: the key hashes the image bytes, the
+contour mode and the threshold values, so reopening a window or
+re-running a batch on an unchanged input skips the whole
+contour/skeleton pipeline.
+"""
+import hashlib
+import os
+import numpy as np
+from dot2dot.utils import get_base_directory
+
+
+def get_cache_directory():
+    """
+    Returns the cache directory under the config directory, creating it
+    if needed.
+    """
+    base_directory = get_base_directory()
+    cache_directory = os.path.join(base_directory, 'assets', 'config',
+                                   'discretization_cache')
+    if not os.path.exists(cache_directory):
+        os.makedirs(cache_directory)
+    return cache_directory
+
+
+def compute_cache_key(image_path, contour_mode, threshold_values):
+    """
+    Computes the content-addressed key for one discretization run:
+    a hash of the image bytes, the contour mode and the threshold values.
+
+    Returns:
+        str or None: Hex digest usable as a file name, or None when the
+                     image cannot be read.
+    """
+    try:
+        with open(image_path, 'rb') as file:
+            image_bytes = file.read()
+    except OSError:
+        return None
+
+    digest = hashlib.sha1()
+    digest.update(image_bytes)
+    digest.update(str(contour_mode).encode('utf-8'))
+    digest.update(str(list(threshold_values)).encode('utf-8'))
+    return digest.hexdigest()
+
+
+def load_cached_result(cache_key):
+    """
+    Loads a cached discretization result.
+
+    Returns:
+        tuple or None: (positions, have_multiple_contours) where positions
+        is an (N, 2) int32 array of (x, y) dot positions, or None when no
+        valid entry exists for the key.
+    """
+    if cache_key is None:
+        return None
+    cache_path = os.path.join(get_cache_directory(), f"{cache_key}.npz")
+    if not os.path.isfile(cache_path):
+        return None
+    try:
+        with np.load(cache_path) as data:
+            positions = data['positions']
+            have_multiple_contours = bool(data['have_multiple_contours'])
+        return positions, have_multiple_contours
+    except Exception as e:
+        print(f"Ignoring corrupted discretization cache entry: {e}")
+        return None
+
+
+def store_cached_result(cache_key, positions, have_multiple_contours):
+    """
+    Stores a discretization result as a compact binary file.
+
+    Args:
+        cache_key (str): Key from compute_cache_key.
+        positions (numpy.ndarray): (N, 2) int32 array of (x, y) positions.
+        have_multiple_contours (bool): Whether several contours were found.
+    """
+    if cache_key is None:
+        return
+    cache_path = os.path.join(get_cache_directory(), f"{cache_key}.npz")
+    try:
+        np.savez(cache_path,
+                 positions=np.asarray(positions, dtype=np.int32),
+                 have_multiple_contours=have_multiple_contours)
+    except Exception as e:
+        print(f"Could not write discretization cache entry: {e}")
@@ -0,0 +1,196 @@
+"""
+Structure-of-arrays backing store for dots.
+Positions, radii and colors live in contiguous numpy arrays so bulk
+geometric operations (overlaps, bounding boxes, nearest-dot queries)
+run vectorized, while the existing per-dot API stays available through
+lightweight DotView objects that read and write the shared arrays.
+"""
+
+from collections import defaultdict
+import numpy as np
+from dot2dot.dot import Dot
+
+
+class DotView:
+    """
+    Lightweight view over one entry of a DotCollection, mirroring the
+    Dot API (position, dot_id, color, radius, label, overlap flags)
+    without owning any geometry itself.
+    """
+
+    def __init__(self, collection, index):
+        self._collection = collection
+        self._index = index
+
+    @property
+    def position(self):
+        x, y = self._collection.positions[self._index]
+        return (int(x), int(y))
+
+    @position.setter
+    def position(self, value):
+        self._collection.positions[self._index] = value
+
+    @property
+    def radius(self):
+        return float(self._collection.radii[self._index])
+
+    @radius.setter
+    def radius(self, value):
+        self._collection.radii[self._index] = value
+
+    @property
+    def color(self):
+        return tuple(int(c) for c in self._collection.colors[self._index])
+
+    @color.setter
+    def color(self, value):
+        self._collection.colors[self._index] = value
+
+    @property
+    def dot_id(self):
+        return int(self._collection.dot_ids[self._index])
+
+    @property
+    def label(self):
+        return self._collection.labels[self._index]
+
+    @label.setter
+    def label(self, value):
+        self._collection.labels[self._index] = value
+
+    def __repr__(self):
+        return (f"DotView(position={self.position}, dot_id={self.dot_id}, "
+                f"color={self.color}, radius={self.radius})")
+
+
+class DotCollection:
+    """
+    Contiguous-array store for a set of dots with vectorized bulk
+    geometry. Built from (and convertible back to) lists of Dot objects
+    so it can slot into the existing pipeline.
+
+    Attributes:
+        positions (numpy.ndarray): (N, 2) float64 array of (x, y) centers.
+        radii (numpy.ndarray): (N,) float64 array of dot radii.
+        colors (numpy.ndarray): (N, 4) uint8 array of RGBA colors.
+        dot_ids (numpy.ndarray): (N,) int32 array of dot identifiers.
+        labels (list): Per-dot DotLabel objects (or None).
+    """
+
+    def __init__(self, dots=None):
+        dots = dots or []
+        num_dots = len(dots)
+        self.positions = np.zeros((num_dots, 2), dtype=np.float64)
+        self.radii = np.zeros(num_dots, dtype=np.float64)
+        self.colors = np.zeros((num_dots, 4), dtype=np.uint8)
+        self.dot_ids = np.zeros(num_dots, dtype=np.int32)
+        self.labels = [None] * num_dots
+
+        for index, dot in enumerate(dots):
+            self.positions[index] = dot.position
+            self.radii[index] = dot.radius
+            self.colors[index] = dot.color
+            self.dot_ids[index] = dot.dot_id
+            self.labels[index] = dot.label
+
+        self._views = [DotView(self, index) for index in range(num_dots)]
+
+    def __len__(self):
+        return len(self._views)
+
+    def __getitem__(self, index):
+        return self._views[index]
+
+    def __iter__(self):
+        return iter(self._views)
+
+    def to_dots(self):
+        """
+        Materializes the collection back into plain Dot objects.
+        """
+        dots = []
+        for view in self._views:
+            dot = Dot(position=view.position, dot_id=view.dot_id)
+            dot.color = view.color
+            dot.radius = view.radius
+            dot.label = view.label
+            dots.append(dot)
+        return dots
+
+    def bounding_boxes(self):
+        """
+        Returns the (N, 4) array of per-dot bounding boxes as
+        (x_min, y_min, x_max, y_max), computed in one vectorized pass.
+        """
+        radii = self.radii[:, np.newaxis]
+        return np.hstack(
+            (self.positions - radii, self.positions + radii))
+
+    def nearest_dot(self, position):
+        """
+        Finds the dot closest to the given (x, y) position.
+
+        Returns:
+            tuple: (index, distance), or (None, inf) if the collection is
+                   empty.
+        """
+        if len(self._views) == 0:
+            return None, float('inf')
+        deltas = self.positions - np.asarray(position, dtype=np.float64)
+        distances_sq = np.einsum('ij,ij->i', deltas, deltas)
+        index = int(np.argmin(distances_sq))
+        return index, float(np.sqrt(distances_sq[index]))
+
+    def overlapping_dot_pairs(self, cell_size):
+        """
+        Finds every pair of overlapping dots. Dots are binned into grid
+        cells of the given size, then each cell and its neighbors are
+        tested pairwise with vectorized distance checks, so the cost stays
+        proportional to the local density instead of N**2.
+
+        Returns:
+            list: (i, j) index pairs with i < j whose dots overlap.
+        """
+        if len(self._views) < 2:
+            return []
+
+        cells = defaultdict(list)
+        cell_indices = np.floor(self.positions / cell_size).astype(np.int64)
+        for index, (col, row) in enumerate(cell_indices):
+            cells[(row, col)].append(index)
+
+        pairs = []
+        seen = set()
+        for (row, col), members in cells.items():
+            # Gather this cell plus its 8 neighbors
+            candidates = list(members)
+            for d_row in (-1, 0, 1):
+                for d_col in (-1, 0, 1):
+                    if d_row == 0 and d_col == 0:
+                        continue
+                    candidates.extend(
+                        cells.get((row + d_row, col + d_col), ()))
+
+            if len(candidates) < 2:
+                continue
+            members_array = np.array(members, dtype=np.int64)
+            candidates_array = np.array(candidates, dtype=np.int64)
+
+            deltas = (self.positions[members_array][:, np.newaxis, :] -
+                      self.positions[candidates_array][np.newaxis, :, :])
+            distances_sq = np.einsum('ijk,ijk->ij', deltas, deltas)
+            radii_sums = (self.radii[members_array][:, np.newaxis] +
+                          self.radii[candidates_array][np.newaxis, :])
+            overlap_mask = distances_sq < radii_sums**2
+
+            for i_local, j_local in zip(*np.nonzero(overlap_mask)):
+                i = int(members_array[i_local])
+                j = int(candidates_array[j_local])
+                if i >= j:
+                    continue
+                if (i, j) not in seen:
+                    seen.add((i, j))
+                    pairs.append((i, j))
+
+        return pairs
@@ -20,6 +20,8 @@ class DotsConfig:
         distance_max (float or None): Maximum distance between dots.
         epsilon (float): Epsilon value for contour approximation.
         shape_detection (str): Shape detection mode ('automatic', 'path', 'contour').
+        label_time_budget (float): Seconds allowed for the extra label
+            placement pass resolving unplaced labels (0 disables it).
     """
 
     MAX_ATTRIBUTES = 7
@@ -35,6 +37,7 @@ class DotsConfig:
         distance_max=None,
         epsilon=0.01,
         shape_detection="automatic",
+        label_time_budget=0.0,
     ):
         """
         Initializes a DotsConfig instance.
@@ -49,6 +52,8 @@ class DotsConfig:
             distance_max (float or None): Maximum distance between dots. Default is None.
             epsilon (float): Epsilon value for contour approximation. Default is 0.01.
             shape_detection (str): Shape detection mode. Default is "automatic".
+            label_time_budget (float): Seconds for the extra label placement
+                pass. Default is 0.0 (disabled).
         """
         self.dot_control = dot_control
         self.input_path = input_path
@@ -59,6 +64,7 @@ class DotsConfig:
         self.distance_max = distance_max
         self.epsilon = epsilon
         self.shape_detection = shape_detection.lower()
+        self.label_time_budget = label_time_budget
 
         if not self.is_valid():
             print("DotsConfig is invalid")
@@ -97,6 +103,7 @@ class DotsConfig:
             distance_max=distance_max,
             epsilon=args.epsilon,
             shape_detection=args.shapeDetection.lower(),
+            label_time_budget=float(args.labelTimeBudget),
         )
 
     def is_valid(self):
@@ -192,6 +199,12 @@ class DotsConfig:
             config["distance"][1]) if config["distance"][1] else None
         input_path = config["input"]
 
+        # Older config files may predate the key
+        try:
+            label_time_budget = float(config["labelTimeBudget"] or 0.0)
+        except (KeyError, ValueError):
+            label_time_budget = 0.0
+
         if apply_input_path is False and old_dots_config:
             input_path = old_dots_config.input_path
 
@@ -205,4 +218,5 @@ class DotsConfig:
             distance_max=distance_max,
             epsilon=float(config["epsilon"]),
             shape_detection=config["shapeDetection"].lower(),
+            label_time_budget=label_time_budget,
         )
@@ -3,16 +3,19 @@ dots_exporter.py
 Export utilities for Dot2Dot:
 - Save rendered image (PNG/JPEG)
 - Save polygon as GeoJSON/JSON (optionally normalized to [0,1] using max(width, height))
+- Save vector output (SVG/PDF) or a CSV table of the dots, all
+  streamed incrementally through dot2dot.streaming_export
 """
 
-import json
 import tkinter as tk
 import traceback
 from tkinter import filedialog, messagebox
-from typing import List, Tuple
+from typing import Tuple
 
 import numpy as np
 
+from dot2dot import streaming_export
+from dot2dot.dot_collection import DotCollection
 from dot2dot.gui.error_window import ErrorWindow
 from dot2dot.gui.popup_2_buttons import Popup2Buttons
 
@@ -41,6 +44,9 @@ class DotsExporter:
         - If the chosen path ends with .png/.jpg/.jpeg: save the rendered image.
         - If the chosen path ends with .json/.geojson: save a GeoJSON Polygon
           built from processed dots (pixel coordinates).
+        - If the chosen path ends with .svg/.pdf: save vector output built
+          directly from the dots, without rasterizing.
+        - If the chosen path ends with .csv: save one row per dot.
         """
         has_image = (
             getattr(self.main_gui, "processed_image", None) is not None
@@ -58,8 +64,11 @@ class DotsExporter:
                 ("GeoJSON/JSON files", "*.json;*.geojson"),
                 ("PNG files", "*.png"),
                 ("JPEG files", "*.jpg;*.jpeg"),
+                ("SVG files", "*.svg"),
+                ("PDF files", "*.pdf"),
+                ("CSV files", "*.csv"),
             ],
-            title="Save Image or Polygon (GeoJSON)",
+            title="Save Image, Vector Output or Polygon (GeoJSON)",
         )
         if not self.save_path:
             return
@@ -72,6 +81,15 @@ class DotsExporter:
             if lower.endswith((".json", ".geojson")):
                 self._export_polygon_geojson(self.save_path)
                 return
+            if lower.endswith(".svg"):
+                self._export_svg(self.save_path)
+                return
+            if lower.endswith(".pdf"):
+                self._export_pdf(self.save_path)
+                return
+            if lower.endswith(".csv"):
+                self._export_csv(self.save_path)
+                return
 
             messagebox.showerror("Error", "Unsupported file format.")
         except Exception:
@@ -114,49 +132,26 @@ class DotsExporter:
 
         apply_centered_scale = self._ask_normalize()  # repurposed prompt
 
-        ring: List[List[float]] = []
+        # DotCollection builds the float64 position array in one pass;
+        # the copy is ours, so the in-place transforms below are safe
+        positions = DotCollection(dots).positions
         if apply_centered_scale:
-            # 1) center of mass
-            sx = 0.0
-            sy = 0.0
-            for d in dots:
-                x, y = d.position
-                sx += float(x)
-                sy += float(y)
-            n = float(len(dots))
-            cx = sx / n
-            cy = sy / n
-
-            # 2) uniform scale from farthest horizontal/vertical displacement
-            max_dx = 0.0
-            max_dy = 0.0
-            for d in dots:
-                x, y = d.position
-                dx = abs(float(x) - cx)
-                dy = abs(float(y) - cy)
-                if dx > max_dx:
-                    max_dx = dx
-                if dy > max_dy:
-                    max_dy = dy
-            max_disp = max(max_dx, max_dy)
+            # Center on the centroid and scale uniformly so the farthest
+            # displacement maps to 1; FLIP Y so up is positive.
+            center = positions.mean(axis=0)
+            max_disp = np.abs(positions - center).max()
             if max_disp <= 1e-12:
                 messagebox.showerror(
                     "Error",
                     "Cannot scale: all dots collapse at the same position.",
                 )
                 return
-            S = 1.0 / max_disp
-
-            # 3) transform to [-1, 1] with uniform scaling on both axes
-            #    FLIP Y: negate the vertical offset so up is positive.
-            for d in dots:
-                x, y = d.position
-                x_t = (float(x) - cx) * S
-                y_t = -(float(y) - cy) * S  # <-- flip
-                ring.append([x_t, y_t])
+            positions = (positions - center) / max_disp
+            positions[:, 1] = -positions[:, 1]  # <-- flip
         else:
             # raw pixel coordinates
             # map image pixel y (down) to world y (up): y' = H - 1 - y
+            positions = np.floor(positions)
             _, h = self._get_image_size()
             if h <= 0:
                 # if we cannot determine height, warn and fall back (no flip)
@@ -164,26 +159,49 @@ class DotsExporter:
                     "Warning",
                     "Image height unavailable; exported polygon may appear vertically flipped.",
                 )
-                for d in dots:
-                    x, y = d.position
-                    ring.append([int(x), int(y)])
             else:
-                for d in dots:
-                    x, y = d.position
-                    y_flipped = (h - 1) - int(y)
-                    ring.append([int(x), y_flipped])
+                positions[:, 1] = (h - 1) - positions[:, 1]
 
-        # close the ring
-        if ring[0] != ring[-1]:
-            ring.append(ring[0])
+        # The ring is streamed pair by pair and closed by the writer;
+        # no intermediate GeoJSON dict is built
+        streaming_export.write_geojson_polygon(path, positions)
 
-        geojson = {"type": "Polygon", "coordinates": [ring]}
-        serializable = _convert_to_serializable(geojson)
+        messagebox.showinfo("Success", f"Polygon saved to {path}.")
 
-        with open(path, "w", encoding="utf-8") as f:
-            json.dump(serializable, f, indent=2)
+    def _export_svg(self, path: str) -> None:
+        """
+        Write the dots and labels as an SVG document, streamed directly
+        from the dot list.
+        """
+        dots = getattr(self.main_gui, "processed_dots", None)
+        if not dots:
+            messagebox.showerror("Error", "No dots to export.")
+            return
+        streaming_export.write_svg(path, dots, self._get_image_size())
+        messagebox.showinfo("Success", f"SVG saved to {path}.")
 
-        messagebox.showinfo("Success", f"Polygon saved to {path}.")
+    def _export_pdf(self, path: str) -> None:
+        """
+        Write the dots and labels as a single-page vector PDF, streamed
+        directly from the dot list.
+        """
+        dots = getattr(self.main_gui, "processed_dots", None)
+        if not dots:
+            messagebox.showerror("Error", "No dots to export.")
+            return
+        streaming_export.write_pdf(path, dots, self._get_image_size())
+        messagebox.showinfo("Success", f"PDF saved to {path}.")
+
+    def _export_csv(self, path: str) -> None:
+        """
+        Write one CSV row per dot (dot_id, x, y, radius).
+        """
+        dots = getattr(self.main_gui, "processed_dots", None)
+        if not dots:
+            messagebox.showerror("Error", "No dots to export.")
+            return
+        streaming_export.write_csv(path, dots)
+        messagebox.showinfo("Success", f"CSV saved to {path}.")
 
     def _ask_normalize(self) -> bool:
         """
@@ -245,22 +263,3 @@ class DotsExporter:
             return int(w), int(h)
 
         return 0, 0
-
-
-def _convert_to_serializable(data):
-    """
-    Recursively convert NumPy types to native Python types.
-    Mirrors DotsSaver.convert_to_serializable without importing it
-    to avoid cyclic dependencies.
-    """
-    if isinstance(data, dict):
-        return {k: _convert_to_serializable(v) for k, v in data.items()}
-    if isinstance(data, list):
-        return [_convert_to_serializable(x) for x in data]
-    if isinstance(data, tuple):
-        return tuple(_convert_to_serializable(x) for x in data)
-    if isinstance(data, np.ndarray):
-        return data.tolist()
-    if isinstance(data, np.generic):
-        return data.item()
-    return data
@@ -4,7 +4,6 @@ Module to enable the save and load of d2d/png file.
 
 import json
 import os
-import threading
 import tkinter as tk
 import traceback
 from tkinter import filedialog, messagebox
@@ -12,6 +11,7 @@ from tkinter import filedialog, messagebox
 import cv2
 import numpy as np
 
+from dot2dot import d2d_format
 from dot2dot.dot import Dot, DotLabel
 from dot2dot.dots_config import DotsConfig
 from dot2dot.dots_exporter import DotsExporter
@@ -92,35 +92,40 @@ class DotsSaver:
     def save_d2d(self, dots, dots_config):
         """
         Save the current state (metadata + dots config + list of dots) into a .d2d file.
-        This method coordinates the save process by calling set_save_path and create_save_data in parallel.
+        .d2d files use the columnar binary container from d2d_format;
+        the legacy JSON document stays available as .d2d.json for
+        interchange with other tools.
         """
         try:
-            # Start a background thread to prepare the save data
-            save_data_thread = threading.Thread(
-                target=self.create_save_data, args=(dots, dots_config)
-            )
-            save_data_thread.start()
-
             # Ask the user where to save and what format (e.g., .d2d or .png)
             file_types = [
                 ("Dot2Dot files", "*.d2d"),
+                ("Dot2Dot JSON files", "*.d2d.json"),
                 ("PNG files", "*.png"),
                 ("JPEG files", "*.jpg;*.jpeg"),
             ]
             if not self.set_save_path(file_types):
                 return  # If the user cancels, do nothing
 
-            # Wait for the save data to be prepared
-            save_data_thread.join()
-
             # Check the file extension and save accordingly
-            if self.save_path.endswith(".d2d"):
+            if self.save_path.endswith(".d2d.json"):
+                # Legacy JSON path, kept for interchange
+                self.create_save_data(dots, dots_config)
                 if self.save_data:
                     # Write the data to the JSON file
                     with open(self.save_path, "w") as f:
                         json.dump(self.save_data, f, indent=4)
                     self.update_main_window_name()
                     self.main_gui.needs_save = False
+            elif self.save_path.endswith(".d2d"):
+                d2d_format.write_binary_d2d(
+                    self.save_path,
+                    dots,
+                    self._dots_config_to_dict(dots_config),
+                    read_metadata(),
+                )
+                self.update_main_window_name()
+                self.main_gui.needs_save = False
             elif self.save_path.endswith((".png", ".jpg", ".jpeg")):
                 # Save the image using PIL (if it's an image file)
                 self.main_gui.original_output_image.save(self.save_path)
@@ -274,12 +279,22 @@ class DotsSaver:
             self.main_gui.set_input_image()
             return
 
-        elif file_path.endswith(".d2d"):
+        elif file_path.endswith((".d2d", ".d2d.json")):
             print(f"Load {file_path}...")
-            # For .d2d files, read the data
+            # For .d2d files, read the data: binary container files are
+            # detected from their magic bytes, anything else is the
+            # legacy JSON document
             try:
-                with open(file_path, "r") as f:
-                    data = json.load(f)
+                binary_file = None
+                if d2d_format.is_binary_d2d(file_path):
+                    binary_file = d2d_format.D2DBinaryFile(file_path)
+                    data = {
+                        "metadata": binary_file.metadata,
+                        "dots_config": binary_file.dots_config_data,
+                    }
+                else:
+                    with open(file_path, "r") as f:
+                        data = json.load(f)
 
                 # Extract dots and configuration from the .d2d file
                 dots_config_data = data.get("dots_config")
@@ -299,7 +314,9 @@ class DotsSaver:
                 dot_control.label.anchor = dot_control_label_data["anchor"]
 
                 try:
-                    data = self.check_file_path_load_d2d(data, file_path)
+                    data = self.check_file_path_load_d2d(
+                        data, file_path, binary_file
+                    )
                 except FileNotFoundError:
                     print(
                         "Warning: couldn't find the input image while loading the path. We continue the loading but all features might not work."
@@ -319,35 +336,40 @@ class DotsSaver:
                         "shape_detection"
                     ].lower(),
                 )
-                dots = []
-                for dot_data in dots_data:
-                    dot = Dot(
-                        position=tuple(dot_data["position"]),
-                        dot_id=dot_data["dot_id"],
-                    )
-                    dot.radius = dot_data["radius"]
-                    dot.color = tuple(dot_data["color"])
-                    dots.append(dot)
-
-                # Set the label for each dot
-                for dot, dot_data in zip(dots, dots_data):
-                    label_data = dot_data.get("label")
-                    if label_data:
-                        dot.label = DotLabel(
-                            dot.position,
-                            dot.radius,
-                            tuple(label_data["color"]),
-                            label_data["font_path"],
-                            label_data["font_size"],
-                            dot_data["dot_id"],
+                if binary_file is not None:
+                    # Columns are memory-mapped and only materialized
+                    # into Dot objects here
+                    dots = binary_file.to_dots()
+                else:
+                    dots = []
+                    for dot_data in dots_data:
+                        dot = Dot(
+                            position=tuple(dot_data["position"]),
+                            dot_id=dot_data["dot_id"],
                         )
-                        position = label_data["position"]
-                        position_tuple = (
-                            np.int32(position[0]),
-                            np.int32(position[1]),
-                        )
-                        dot.label.position = position_tuple
-                        dot.label.anchor = label_data["anchor"]
+                        dot.radius = dot_data["radius"]
+                        dot.color = tuple(dot_data["color"])
+                        dots.append(dot)
+
+                    # Set the label for each dot
+                    for dot, dot_data in zip(dots, dots_data):
+                        label_data = dot_data.get("label")
+                        if label_data:
+                            dot.label = DotLabel(
+                                dot.position,
+                                dot.radius,
+                                tuple(label_data["color"]),
+                                label_data["font_path"],
+                                label_data["font_size"],
+                                dot_data["dot_id"],
+                            )
+                            position = label_data["position"]
+                            position_tuple = (
+                                np.int32(position[0]),
+                                np.int32(position[1]),
+                            )
+                            dot.label.position = position_tuple
+                            dot.label.anchor = label_data["anchor"]
 
                 self.main_gui.processed_dots = dots
                 self.main_gui.dots_config = dots_config
@@ -372,11 +394,12 @@ class DotsSaver:
             # If the file type is not supported
             messagebox.showerror("Error", "Unsupported file format.")
 
-    def check_file_path_load_d2d(self, data, d2d_file_path):
+    def check_file_path_load_d2d(self, data, d2d_file_path, binary_file=None):
         """
         Checks if the input image path in data["dots_config"] exists.
         If it doesn't, prompts the user to select a new image file and updates the path.
-        The updated data is written back to the .d2d file.
+        The updated data is written back to the .d2d file, in the binary
+        container format when `binary_file` is given.
         """
         dots_config_data = data.get("dots_config", {})
         input_path = dots_config_data.get("input_path", "")
@@ -424,8 +447,21 @@ class DotsSaver:
             # If the user selected a new path, write the updated data back to the .d2d file
             if new_path_selected[0]:
                 try:
-                    with open(d2d_file_path, "w") as f:
-                        json.dump(data, f, indent=4)
+                    if binary_file is not None:
+                        # Materialize the dots, then release the column
+                        # mappings: Windows refuses to truncate a file
+                        # that is still memory-mapped
+                        dots = binary_file.to_dots()
+                        binary_file.close()
+                        d2d_format.write_binary_d2d(
+                            d2d_file_path,
+                            dots,
+                            dots_config_data,
+                            binary_file.metadata,
+                        )
+                    else:
+                        with open(d2d_file_path, "w") as f:
+                            json.dump(data, f, indent=4)
                     messagebox.showinfo(
                         "Success",
                         f"The {d2d_file_path} file has been updated with the new input image path.",
@@ -1,9 +1,10 @@
 # dots_selection.py
 
+import heapq
 from typing import List, Tuple, Optional
 import numpy as np
 import cv2
-from dot2dot.utils import point_distance, insert_midpoints, filter_close_points, calculate_area
+from dot2dot.utils import insert_midpoints, filter_close_points, calculate_area
 from dot2dot.dot import Dot
 
 
@@ -64,21 +65,19 @@ class DotsSelection:
         if area < 0:
             # Reverse the order of `self.dots`
             self.dots = self.dots[::-1]
+            contour = contour[::-1]
 
-        # Convert to (x, y) tuples
-        original_points = [dot.position for dot in self.dots]
-        original_start_point = original_points[0]
+        # Keep the points in (N, 2) array form for the whole chain
+        original_start_point = contour[0].astype(np.float64)
 
-        approx = cv2.approxPolyDP(np.array(original_points, dtype=np.int32),
-                                  self.epsilon_factor, True)
-
-        # Convert to a list of (x, y) tuples
-        points = [(point[0][0], point[0][1]) for point in approx]
+        approx = cv2.approxPolyDP(contour, self.epsilon_factor, True)
+        points = approx.reshape(-1, 2)
 
         # Reorder points to start from the point closest to the original start point
-        distances = [point_distance(original_start_point, p) for p in points]
-        min_index = distances.index(min(distances))
-        points = points[min_index:] + points[:min_index]
+        distances = np.hypot(points[:, 0] - original_start_point[0],
+                             points[:, 1] - original_start_point[1])
+        min_index = int(np.argmin(distances))
+        points = np.roll(points, -min_index, axis=0)
         # Insert midpoints if needed
         if self.max_distance is not None:
             points = insert_midpoints(points, self.max_distance)
@@ -88,7 +87,7 @@ class DotsSelection:
 
         # Update self.dots with new positions
         self.dots = [
-            Dot(position=point, dot_id=idx + 1)
+            Dot(position=(int(point[0]), int(point[1])), dot_id=idx + 1)
             for idx, point in enumerate(points)
         ]
 
@@ -116,37 +115,158 @@ class DotsSelection:
         if len(points) < 3:
             return points
 
-        # Initialize effective areas
-        effective_areas = [float('inf')]  # First point has infinite area
-        for i in range(1, len(points) - 1):
-            area = calculate_area(points[i - 1], points[i], points[i + 1])
-            effective_areas.append(area)
-        effective_areas.append(float('inf'))  # Last point has infinite area
+        num_total = len(points)
 
-        # Loop until the desired number of points is reached
-        while True:
-            # Find the point with the smallest area (exclude first and last)
-            min_area = min(effective_areas[1:-1])
-            min_index = effective_areas.index(min_area)
+        # Doubly-linked neighbor structure over point indices, so removing
+        # a point and finding its neighbors is O(1)
+        prev_index = list(range(-1, num_total - 1))
+        next_index = list(range(1, num_total + 1))
+        next_index[-1] = -1
+        removed = [False] * num_total
 
+        # Min-heap of (area, index, version). Stale entries are invalidated
+        # lazily: each recomputation bumps the point's version and pushes a
+        # fresh entry, and outdated ones are skipped on pop.
+        versions = [0] * num_total
+        heap = []
+        for i in range(1, num_total - 1):
+            area = calculate_area(points[i - 1], points[i], points[i + 1])
+            heap.append((area, i, 0))
+        heapq.heapify(heap)
+
+        remaining = num_total
+        while heap:
             # Check stopping conditions
-            if num_points is not None and len(points) <= num_points:
+            if num_points is not None and remaining <= num_points:
                 break
-            if threshold is not None and min_area >= threshold:
+
+            area, index, version = heapq.heappop(heap)
+            if removed[index] or version != versions[index]:
+                continue  # Stale heap entry
+
+            if threshold is not None and area >= threshold:
                 break
 
-            # Remove the point with the smallest area
-            del points[min_index]
-            del effective_areas[min_index]
-
-            # Recalculate areas for affected points
-            if 1 <= min_index - 1 < len(points) - 1:
-                effective_areas[min_index - 1] = calculate_area(
-                    points[min_index - 2], points[min_index - 1],
-                    points[min_index])
-            if 1 <= min_index < len(points) - 1:
-                effective_areas[min_index] = calculate_area(
-                    points[min_index - 1], points[min_index],
-                    points[min_index + 1])
-
-        return points
+            # Remove the point with the smallest area by relinking neighbors
+            removed[index] = True
+            remaining -= 1
+            left = prev_index[index]
+            right = next_index[index]
+            next_index[left] = right
+            prev_index[right] = left
+
+            # Recalculate areas for the two affected neighbors
+            for neighbor in (left, right):
+                if prev_index[neighbor] == -1 or next_index[neighbor] == -1:
+                    continue  # Endpoints keep an infinite area
+                versions[neighbor] += 1
+                new_area = calculate_area(points[prev_index[neighbor]],
+                                          points[neighbor],
+                                          points[next_index[neighbor]])
+                heapq.heappush(heap, (new_area, neighbor, versions[neighbor]))
+
+        return [
+            point for index, point in enumerate(points) if not removed[index]
+        ]
+
+    def build_simplification_ladder(
+            self, points: List[Tuple[int,
+                                     int]]) -> Tuple[List[int], List[float]]:
+        """
+        Computes the full Visvalingam–Whyatt removal order of a path once,
+        so that any target point count or area threshold can then be
+        answered by a simple O(n) slice (see simplify_from_ladder) instead
+        of re-running the simplification.
+
+        Args:
+            points (List[Tuple[int, int]]): List of (x, y) points.
+
+        Returns:
+            Tuple[List[int], List[float]]: Per-point elimination ranks
+            (order of removal; surviving endpoints get rank len(points))
+            and the effective area at which each point is removed, clamped
+            to be non-decreasing so threshold queries are consistent.
+        """
+        num_total = len(points)
+        removal_ranks = [num_total] * num_total
+        removal_areas = [float('inf')] * num_total
+        if num_total < 3:
+            return removal_ranks, removal_areas
+
+        prev_index = list(range(-1, num_total - 1))
+        next_index = list(range(1, num_total + 1))
+        next_index[-1] = -1
+
+        versions = [0] * num_total
+        heap = []
+        for i in range(1, num_total - 1):
+            area = calculate_area(points[i - 1], points[i], points[i + 1])
+            heap.append((area, i, 0))
+        heapq.heapify(heap)
+
+        rank = 0
+        last_area = 0.0
+        while heap:
+            area, index, version = heapq.heappop(heap)
+            if removal_ranks[index] < num_total or version != versions[index]:
+                continue  # Already removed or stale heap entry
+
+            # Clamp so the sequence of removal areas is monotonic
+            last_area = max(last_area, area)
+            removal_ranks[index] = rank
+            removal_areas[index] = last_area
+            rank += 1
+
+            left = prev_index[index]
+            right = next_index[index]
+            next_index[left] = right
+            prev_index[right] = left
+
+            for neighbor in (left, right):
+                if prev_index[neighbor] == -1 or next_index[neighbor] == -1:
+                    continue
+                versions[neighbor] += 1
+                new_area = calculate_area(points[prev_index[neighbor]],
+                                          points[neighbor],
+                                          points[next_index[neighbor]])
+                heapq.heappush(heap, (new_area, neighbor, versions[neighbor]))
+
+        return removal_ranks, removal_areas
+
+    def simplify_from_ladder(
+            self,
+            points: List[Tuple[int, int]],
+            ladder: Tuple[List[int], List[float]],
+            num_points: Optional[int] = None,
+            threshold: Optional[float] = None) -> List[Tuple[int, int]]:
+        """
+        Simplifies a path in O(n) by slicing a precomputed removal-order
+        ladder (see build_simplification_ladder).
+
+        Args:
+            points (List[Tuple[int, int]]): The same points the ladder was
+                                            built from.
+            ladder (Tuple[List[int], List[float]]): Elimination ranks and
+                                                    removal areas.
+            num_points (Optional[int]): Desired number of surviving points.
+            threshold (Optional[float]): Keep points whose removal area is
+                                         at least this value.
+
+        Returns:
+            List[Tuple[int, int]]: Simplified list of points.
+        """
+        removal_ranks, removal_areas = ladder
+        num_total = len(points)
+
+        if num_points is not None:
+            cutoff = num_total - num_points
+            return [
+                point for index, point in enumerate(points)
+                if removal_ranks[index] >= cutoff
+            ]
+        if threshold is not None:
+            return [
+                point for index, point in enumerate(points)
+                if removal_areas[index] >= threshold
+            ]
+        return list(points)
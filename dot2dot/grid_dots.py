@@ -4,6 +4,7 @@ Module for managing dots and labels in a grid structure for spatial organization
 
 from collections import defaultdict
 import numpy as np
+from dot2dot import label_metrics
 from dot2dot.dot import Dot
 from dot2dot.dot_label import DotLabel
 
@@ -34,6 +35,13 @@ class GridDots:
         self.grid_dots = defaultdict(set)
         self.grid_labels = defaultdict(set)
 
+        # Incremental overlap state: the cell each object currently sits
+        # in, the cells touched since the last overlap update, and the
+        # persistent set of overlapping objects (None = never computed)
+        self.object_cells = {}
+        self.dirty_cells = set()
+        self.overlap_set = None
+
         # Populate the grid with the dots and labels
         for dot in dots:
             self.add_dot_to_grid(dot)
@@ -58,6 +66,21 @@ class GridDots:
         cell_row = max(0, min(cell_row, self.nbr_cells_y - 1))
         return cell_row, cell_col
 
+    def mark_cell_dirty(self, cell_index):
+        """
+        Marks a cell and its 8 neighbors as dirty, so the next
+        update_overlaps call recomputes only those cells.
+
+        Parameters:
+        - cell_index: (cell_row, cell_col) of the cell to mark.
+        """
+        cell_row, cell_col = cell_index
+        for row in range(max(0, cell_row - 1),
+                         min(self.nbr_cells_y, cell_row + 2)):
+            for col in range(max(0, cell_col - 1),
+                             min(self.nbr_cells_x, cell_col + 2)):
+                self.dirty_cells.add((row, col))
+
     def add_dot_to_grid(self, dot):
         """
         Adds a dot to the grid based on its position.
@@ -67,6 +90,8 @@ class GridDots:
         """
         cell_index = self.retrieve_cell_index(dot.position)
         self.grid_dots[cell_index].add(dot)
+        self.object_cells[dot] = cell_index
+        self.mark_cell_dirty(cell_index)
 
     def add_label_to_grid(self, label):
         """
@@ -77,26 +102,34 @@ class GridDots:
         """
         cell_index = self.retrieve_cell_index(label.position)
         self.grid_labels[cell_index].add(label)
+        self.object_cells[label] = cell_index
+        self.mark_cell_dirty(cell_index)
 
     def remove_dot_from_grid(self, dot):
         """
-        Removes a dot from its current grid cell.
+        Removes a dot from its current grid cell. The cell the dot was
+        registered in is used, not its (possibly already updated) position.
 
         Parameters:
         - dot: Dot object to be removed.
         """
-        cell_index = self.retrieve_cell_index(dot.position)
+        cell_index = self.object_cells.pop(
+            dot, self.retrieve_cell_index(dot.position))
         self.grid_dots[cell_index].discard(dot)
+        self.mark_cell_dirty(cell_index)
 
     def remove_label_from_grid(self, label):
         """
-        Removes a label from its current grid cell.
+        Removes a label from its current grid cell. The cell the label was
+        registered in is used, not its (possibly already updated) position.
 
         Parameters:
         - label: DotLabel object to be removed.
         """
-        cell_index = self.retrieve_cell_index(label.position)
+        cell_index = self.object_cells.pop(
+            label, self.retrieve_cell_index(label.position))
         self.grid_labels[cell_index].discard(label)
+        self.mark_cell_dirty(cell_index)
 
     def move_dot_and_label(self, dot):
         """
@@ -148,6 +181,30 @@ class GridDots:
         neighbors.discard(obj)
         return neighbors
 
+    def objects_near(self, position):
+        """
+        Returns the dots and labels registered in the cell containing the
+        given position and its 8 neighbors. Intended for point queries
+        such as click hit testing.
+
+        Parameters:
+        - position: Tuple (x, y) in image coordinates.
+
+        Returns:
+        - (dots, labels): Sets of nearby Dot and DotLabel objects.
+        """
+        dots = set()
+        labels = set()
+        cell_row, cell_col = self.retrieve_cell_index(position)
+        for row in range(max(0, cell_row - 1),
+                         min(self.nbr_cells_y, cell_row + 2)):
+            for col in range(max(0, cell_col - 1),
+                             min(self.nbr_cells_x, cell_col + 2)):
+                cell_index = (row, col)
+                dots.update(self.grid_dots.get(cell_index, set()))
+                labels.update(self.grid_labels.get(cell_index, set()))
+        return dots, labels
+
     def do_overlap(self, obj):
         """
         Checks if the given object (dot or label) overlaps with any of its neighbors.
@@ -209,11 +266,12 @@ class GridDots:
 
     def dots_overlap(self, dot1, dot2):
         """
-        Checks if two dots overlap.
+        Checks if two dots overlap. Plain scalar arithmetic: allocating
+        numpy arrays per pair is slower than the subtraction itself.
         """
-        pos1 = np.array(dot1.position)
-        pos2 = np.array(dot2.position)
-        distance_sq = np.sum((pos1 - pos2)**2)
+        x1, y1 = dot1.position
+        x2, y2 = dot2.position
+        distance_sq = (x1 - x2)**2 + (y1 - y2)**2
         radii_sum = dot1.radius + dot2.radius
         return distance_sq < radii_sum**2
 
@@ -221,12 +279,12 @@ class GridDots:
         """
         Checks if a dot and a label overlap.
         """
-        center = np.array(dot.position)
+        center_x, center_y = dot.position
         radius = dot.radius
         x_min, y_min, x_max, y_max = self.get_label_bbox(label)
-        closest_x = np.clip(center[0], x_min, x_max)
-        closest_y = np.clip(center[1], y_min, y_max)
-        distance_sq = np.sum((center - [closest_x, closest_y])**2)
+        closest_x = min(max(center_x, x_min), x_max)
+        closest_y = min(max(center_y, y_min), y_max)
+        distance_sq = (center_x - closest_x)**2 + (center_y - closest_y)**2
         return distance_sq < radius**2
 
     def labels_overlap(self, label1, label2):
@@ -248,13 +306,9 @@ class GridDots:
         Returns:
         - bbox: (x_min, y_min, x_max, y_max) tuple representing the adjusted bounding box.
         """
-        text = label.text
-        font = label.font
-        try:
-            bbox = font.getbbox(text)
-            width, height = bbox[2] - bbox[0], bbox[3] - bbox[1]
-        except AttributeError:
-            width, height = font.getsize(text)
+        width, height = label_metrics.get_text_size(label.font, label.text,
+                                                    label.font_path,
+                                                    label.font_size)
 
         x, y = label.position
         anchor_adjustments = {
@@ -299,4 +353,34 @@ class GridDots:
                             obj1, neighbor):
                         overlaps.update([obj1, neighbor])
 
+        self.overlap_set = overlaps
+        self.dirty_cells.clear()
         return overlaps
+
+    def update_overlaps(self):
+        """
+        Returns the current set of overlapping objects, recomputing only
+        the cells marked dirty since the last update (a dot drag touches
+        just the source and destination cells plus their neighbors). Falls
+        back to a full find_all_overlaps pass the first time.
+
+        Returns:
+        - overlaps: The persistent set of overlapping objects.
+        """
+        if self.overlap_set is None:
+            return self.find_all_overlaps()
+
+        affected = set()
+        for cell_index in self.dirty_cells:
+            affected.update(self.grid_dots.get(cell_index, set()))
+            affected.update(self.grid_labels.get(cell_index, set()))
+        self.dirty_cells.clear()
+
+        for obj in affected:
+            overlap_found, _, _ = self.do_overlap(obj)
+            if overlap_found:
+                self.overlap_set.add(obj)
+            else:
+                self.overlap_set.discard(obj)
+
+        return self.overlap_set
@@ -8,6 +8,7 @@ import platform
 import time
 import threading
 from PIL import Image, ImageTk
+from dot2dot.image_pyramid import ImagePyramid
 from dot2dot.gui.utilities_gui import set_icon
 from dot2dot.gui.utilities_gui import set_screen_choice
 
@@ -69,6 +70,10 @@ class DisplayWindowBase:
         self.resample_method = Image.Resampling.LANCZOS
         self.bg_update_timer = None
         self.bg_last_call_time = 0
+        # Zoom pyramid over the background image, rebuilt only when the
+        # background itself changes (see _get_background_pyramid)
+        self._bg_pyramid = None
+        self._bg_pyramid_source = None
         # Bind mouse events for zooming and panning
         self.bind_zoom_events()
         self.bind_panning_events()
@@ -202,6 +207,17 @@ class DisplayWindowBase:
         self.opacity_display.config(text=f"{self.bg_opacity:.2f}")
         self.redraw_canvas()
 
+    def _get_background_pyramid(self):
+        """
+        Returns the zoom pyramid of the current background image,
+        rebuilding it only when the background image object changes.
+        """
+        if self._bg_pyramid_source is not self.background_image:
+            self._bg_pyramid = ImagePyramid(self.background_image,
+                                            resample=self.resample_method)
+            self._bg_pyramid_source = self.background_image
+        return self._bg_pyramid
+
     def draw_background(self):
         """
         Draws the background image on the canvas with the current opacity.
@@ -211,21 +227,17 @@ class DisplayWindowBase:
         def delayed_draw():
             # Check if enough time has passed since the last call
             if time.time() - self.bg_last_call_time >= 0.5:
-                # Apply opacity to the original image for display purposes
+                # Scale from the nearest pyramid level instead of
+                # resizing the full-resolution image on every zoom step
+                pyramid = self._get_background_pyramid()
+                scaled_image = pyramid.get_scaled(self.scale)
+
+                # Apply opacity on the (much smaller) scaled image
                 if self.bg_opacity < 1.0:
-                    # Create a copy with adjusted opacity
-                    bg_image = self.background_image.copy()
-                    alpha = bg_image.split()[3]
+                    scaled_image = scaled_image.copy()
+                    alpha = scaled_image.split()[3]
                     alpha = alpha.point(lambda p: p * self.bg_opacity)
-                    bg_image.putalpha(alpha)
-                else:
-                    bg_image = self.background_image
-
-                # Scale the image according to the current scale
-                scaled_width = int(bg_image.width * self.scale)
-                scaled_height = int(bg_image.height * self.scale)
-                scaled_image = bg_image.resize((scaled_width, scaled_height),
-                                               self.resample_method)
+                    scaled_image.putalpha(alpha)
 
                 # Convert the scaled image to a PhotoImage
                 self.background_photo = ImageTk.PhotoImage(scaled_image)
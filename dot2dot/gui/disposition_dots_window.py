@@ -6,9 +6,10 @@ import threading
 import tkinter as tk
 from tkinter import ttk, messagebox
 import numpy as np
-import cv2
 from dot2dot.image_discretization import ImageDiscretization
+from dot2dot.dots_selection import DotsSelection
 from dot2dot.gui.tooltip import Tooltip
+from dot2dot.preview import get_preview_input
 from dot2dot.utils import compute_image_diagonal, insert_midpoints, filter_close_points
 from dot2dot.gui.display_window_base import DisplayWindowBase
 
@@ -96,23 +97,31 @@ class DispositionDotsWindow(DisplayWindowBase):
         Performs the time-consuming image discretization and contour processing in a separate thread.
         """
         try:
-            # Initialize ImageDiscretization and compute contour
+            # Initialize ImageDiscretization and compute contour on a
+            # bounded-size preview; the points are scaled back to full
+            # resolution so the sliders keep working in pixel space
+            preview_path, preview_scale = get_preview_input(
+                self.dots_config.input_path)
             image_discretization = ImageDiscretization(
-                self.dots_config.input_path,
-                self.dots_config.shape_detection.lower(),
+                preview_path, self.dots_config.shape_detection.lower(),
                 self.dots_config.threshold_binary, False)
             self.dots = image_discretization.discretize_image()
             self.contour = np.array([dot.position for dot in self.dots],
                                     dtype=np.int32)
-            self.contour_points = [(point[0], point[1])
-                                   for point in self.contour]
-
-            # Approximate the contour based on epsilon
-            approx = cv2.approxPolyDP(
-                np.array(self.contour_points, dtype=np.int32),
-                self.dots_config.epsilon, True)
-            self.current_points = [(point[0][0], point[0][1])
-                                   for point in approx]
+            if preview_scale != 1.0:
+                self.contour = np.rint(self.contour *
+                                       preview_scale).astype(np.int32)
+            contour_points = [(point[0], point[1]) for point in self.contour]
+
+            # Compute the Visvalingam removal order of the full contour
+            # once; every slider move afterwards is a cheap O(n) slice.
+            self.dots_selection = DotsSelection()
+            self.simplification_ladder = \
+                self.dots_selection.build_simplification_ladder(contour_points)
+            self.contour_points = contour_points
+
+            self.current_points = self._simplified_points(
+                self.dots_config.epsilon)
             self.window.after(0, self.fit_canvas_to_content)
 
         except Exception as e:
@@ -313,6 +322,17 @@ class DispositionDotsWindow(DisplayWindowBase):
         # Adjust the initial view to show all dots and labels
         self.fit_canvas_to_content()
 
+    def _simplified_points(self, epsilon):
+        """
+        Returns the contour simplified for the given epsilon by slicing the
+        precomputed ladder. Visvalingam effective areas scale as the square
+        of a distance tolerance, hence the epsilon**2 threshold.
+        """
+        return self.dots_selection.simplify_from_ladder(
+            self.contour_points,
+            self.simplification_ladder,
+            threshold=float(epsilon)**2)
+
     def on_epsilon_change(self, value):
         """
         Callback function for the epsilon slider.
@@ -322,12 +342,8 @@ class DispositionDotsWindow(DisplayWindowBase):
         self.epsilon_display.config(text=f"{epsilon_slider_value:.4f}")
         if not self.contour_points:
             return
-        # Approximate the contour based on the new epsilon value
-        approx = cv2.approxPolyDP(
-            np.array(self.contour_points, dtype=np.int32),
-            epsilon_slider_value, True)
-        self.current_points = [(point[0][0], point[0][1]) for point in approx]
-        # self.current_points = self.current_points
+        # Slice the precomputed simplification ladder for the new epsilon
+        self.current_points = self._simplified_points(epsilon_slider_value)
 
         # Redraw the dots with the new approximation
         self.draw_dots(self.current_points)
@@ -348,11 +364,8 @@ class DispositionDotsWindow(DisplayWindowBase):
         self.min_distance_display.config(text=f"{min_distance:.0f}")
         self.max_distance_display.config(text=f"{max_distance:.0f}")
 
-        # Adjust points dynamically
-        approx = cv2.approxPolyDP(
-            np.array(self.contour_points, dtype=np.int32),
-            self.epsilon_var.get(), True)
-        points = [(point[0][0], point[0][1]) for point in approx]
+        # Adjust points dynamically from the precomputed ladder
+        points = self._simplified_points(self.epsilon_var.get())
 
         # Insert midpoints for max distance
         if max_distance > 0:
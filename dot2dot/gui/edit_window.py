@@ -7,6 +7,7 @@ from dot2dot.dot import Dot
 from dot2dot.dot_label import DotLabel
 from dot2dot.gui.tooltip import Tooltip
 from dot2dot.utils import distance_to_segment, rgba_to_hex
+from dot2dot import label_metrics
 from dot2dot.grid_dots import GridDots
 from dot2dot.gui.display_window_base import DisplayWindowBase
 from dot2dot.gui.dot_selection_popup import DotSelectionPopup
@@ -23,7 +24,9 @@ class EditWindow(DisplayWindowBase):
             image_height,
             input_image,  # Expected to be a PIL Image object or image path
             config,
-            apply_callback=None):
+            apply_callback=None,
+            autosave=None,
+            baseline_image=None):
         """
         Initializes the EditWindow to allow editing of dots and labels.
 
@@ -35,6 +38,11 @@ class EditWindow(DisplayWindowBase):
         - image_height: Height of the image.
         - input_image: PIL Image object or file path to be used as the background.
         - apply_callback: Function to call when 'Apply' is clicked.
+        - autosave: Optional AutosaveService; edits are journaled so a
+          crash mid-session loses nothing.
+        - baseline_image: Optional PIL Image of the current rendered
+          frame; when given, applying dot moves only re-renders the
+          dirty region instead of redrawing every dot.
         """
         super().__init__(master,
                          title="Edit Dots and Labels",
@@ -48,6 +56,16 @@ class EditWindow(DisplayWindowBase):
         self.update_scrollregion(self.canvas_width, self.canvas_height)
 
         self.apply_callback = apply_callback
+        self.autosave = autosave
+        # Incremental render state: the cached full frame, the region
+        # touched by moves, and whether a structural edit (delete,
+        # insert, renumbering...) forces a full redraw
+        self._rendered_image = None
+        if (baseline_image is not None and baseline_image.size
+                == (int(image_width), int(image_height))):
+            self._rendered_image = baseline_image.convert("RGBA")
+        self._needs_full_render = self._rendered_image is None
+        self._dirty_box = None
         self.dots = copy.deepcopy(dots)
         self.dot_control = copy.deepcopy(dot_control)
         self.overlap_color = (255, 0, 0, 255)  # RGBA for red
@@ -57,6 +75,9 @@ class EditWindow(DisplayWindowBase):
         self.bg_opacity = 0.1  # Default to partially transparent
         self.nu = 50
         self.apply_overlap_detection = True
+        # Retained canvas items for the link lines, so drags only move
+        # the two segments adjacent to the dragged dot
+        self.line_items = []
         # Setup GridDots to detect overlaps
         self.grid = GridDots(image_width, image_height, 80, self.dots)
         overlaps = self.grid.find_all_overlaps()
@@ -128,6 +149,7 @@ class EditWindow(DisplayWindowBase):
         If skip_background is True, it skips redrawing the background for performance.
         """
         self.canvas.delete("all")
+        self.line_items = []
         self.draw_background()
         if self.link_dots_var.get():
             self.draw_link_lines()
@@ -143,7 +165,7 @@ class EditWindow(DisplayWindowBase):
         for dot in self.dots:
             self._draw_dot(dot)
             if dot.label and self.show_labels_var.get():
-                self._draw_label(dot.label, str(dot.dot_id))
+                self._draw_label(dot.label, dot.label.text)
 
     def _draw_dot(self, dot: Dot):
         x, y = dot.position
@@ -179,8 +201,16 @@ class EditWindow(DisplayWindowBase):
         x = self.canvas.canvasx(event.x)
         y = self.canvas.canvasy(event.y)
 
+        # One cell lookup in the overlap grid gives the few dots and
+        # labels worth testing, instead of scanning all of them
+        nearby_dots, nearby_labels = self.grid.objects_near(
+            (x / self.scale, y / self.scale))
+
         # Check if clicking on a dot
-        for dot in self.dots:
+        for dot in nearby_dots:
+            index = dot.dot_id - 1
+            if index >= len(self.dots) or self.dots[index] is not dot:
+                continue  # Stale grid entry (e.g. deleted dot)
             dot_x, dot_y = dot.position
             dot_x_scaled = dot_x * self.scale
             dot_y_scaled = dot_y * self.scale
@@ -188,25 +218,37 @@ class EditWindow(DisplayWindowBase):
             distance = ((x - dot_x_scaled)**2 + (y - dot_y_scaled)**2)**0.5
 
             if distance <= 2 * scaled_radius:
-                self.selected_dot_index = dot.dot_id - 1
-                self.last_selected_dot_index = dot.dot_id - 1
+                self.selected_dot_index = index
+                self.last_selected_dot_index = index
+                # Region at the pre-move position must be re-rendered
+                self._mark_render_dirty(dot)
                 self.offset_x = dot_x_scaled - x
                 self.offset_y = dot_y_scaled - y
                 return
 
-        # Check if clicking on a label
-        for idx, label_item_id in enumerate(self.label_items):
-            if label_item_id:
-                bbox = self.canvas.bbox(label_item_id)
-                if bbox:
-                    x1, y1, x2, y2 = bbox
-                    if x1 <= x <= x2 and y1 <= y <= y2:
-                        self.selected_label_index = idx
-                        self.dots[idx].label.has_move = True
-                        label_x, label_y = self.canvas.coords(label_item_id)
-                        self.selected_label_offset_x = label_x - x
-                        self.selected_label_offset_y = label_y - y
-                        return
+        # Check if clicking on a label, with the bbox served from the
+        # cached metrics rather than canvas.bbox round-trips
+        if self.show_labels_var.get():
+            for label in nearby_labels:
+                idx = label.label_id - 1
+                if idx >= len(self.dots) or self.dots[idx].label is not label:
+                    continue
+                if idx >= len(self.label_items) or not self.label_items[idx]:
+                    continue
+                x_min, y_min, x_max, y_max = self.grid.get_label_bbox(label)
+                if not label.has_move:
+                    y_min += self.add_hoc_offset_y_label
+                    y_max += self.add_hoc_offset_y_label
+                if (x_min * self.scale <= x <= x_max * self.scale
+                        and y_min * self.scale <= y <= y_max * self.scale):
+                    label_item_id = self.label_items[idx]
+                    self.selected_label_index = idx
+                    self._mark_render_dirty(self.dots[idx])
+                    label.has_move = True
+                    label_x, label_y = self.canvas.coords(label_item_id)
+                    self.selected_label_offset_x = label_x - x
+                    self.selected_label_offset_y = label_y - y
+                    return
 
         self.selected_dot_index = None
         self.selected_label_index = None
@@ -223,7 +265,30 @@ class EditWindow(DisplayWindowBase):
         if self.selected_dot_index is not None:
             self._move_dot(x, y)
 
+    def _journal(self, entry):
+        """Forwards one edit to the autosave journal, if enabled."""
+        if self.autosave is not None:
+            self.autosave.record_change(entry)
+
     def on_left_button_release(self, _):
+        if self.selected_dot_index is not None:
+            dot = self.dots[self.selected_dot_index]
+            self._mark_render_dirty(dot)
+            self._journal({
+                "op": "move",
+                "dot_id": self.selected_dot_index + 1,
+                "position": list(dot.position),
+                "label_position":
+                list(dot.label.position) if dot.label else None,
+            })
+        elif self.selected_label_index is not None:
+            self._mark_render_dirty(self.dots[self.selected_label_index])
+            label = self.dots[self.selected_label_index].label
+            self._journal({
+                "op": "move",
+                "dot_id": self.selected_label_index + 1,
+                "label_position": list(label.position),
+            })
         self.selected_dot_index = None
         self.selected_label_index = None
 
@@ -235,9 +300,13 @@ class EditWindow(DisplayWindowBase):
         else:
             return
 
+        # Renumbering changes every following label: full redraw
+        self._needs_full_render = True
         del self.dots[index_to_remove]
-        for idx in range(index_to_remove, len(self.dots)):
-            self.dots[idx].dot_id = idx + 1
+        self._renumber_dots_from(index_to_remove)
+        self._journal({"op": "delete", "dot_id": index_to_remove + 1})
+        # The renumbering invalidates the grid's id-based bookkeeping
+        self._rebuild_grid()
 
         self.redraw_canvas()
         self.selected_dot_index = None
@@ -280,26 +349,83 @@ class EditWindow(DisplayWindowBase):
         new_dot.label.position = (int(x),
                                   int(y) - int(self.add_hoc_offset_y_label))
         new_dot.label.anchor = self.dot_control.label.anchor
+        # Renumbering changes every following label: full redraw
+        self._needs_full_render = True
         self.dots.insert(insert_after_index, new_dot)
+        self._renumber_dots_from(insert_after_index + 1)
+        # Register the new dot (and re-register the renumbered ones)
+        # so grid hit testing keeps finding every dot
+        self._rebuild_grid()
+
+        self._journal({
+            "op": "insert",
+            "dot_id": new_dot_id,
+            "position": list(new_dot.position),
+            "label_position": list(new_dot.label.position),
+        })
+        self.redraw_canvas()
 
-        for idx in range(insert_after_index + 1, len(self.dots)):
+    def _renumber_dots_from(self, start_index):
+        """
+        Restores dot_id == index + 1 (and the matching label_id) from
+        the given index onward; hit testing and the per-index canvas
+        item lists both rely on that invariant. The displayed label text
+        follows the new ids, so a structural edit collapses any
+        per-shape numbering into one global sequence.
+        """
+        for idx in range(start_index, len(self.dots)):
             self.dots[idx].dot_id = idx + 1
+            if self.dots[idx].label:
+                self.dots[idx].label.label_id = idx + 1
+                self.dots[idx].label.text = str(idx + 1)
 
-        self.redraw_canvas()
+    def _rebuild_grid(self):
+        """
+        Rebuilds the overlap grid after a structural edit (insert or
+        delete), so every dot and label is registered under its current
+        id. Patching individual cells is error-prone once ids shift.
+        """
+        self.grid = GridDots(self.canvas_width, self.canvas_height, 80,
+                             self.dots)
+        if self.apply_overlap_detection:
+            # Recompute overlap colors from scratch on the fresh grid
+            for dot in self.dots:
+                dot.color = self.dot_control.color
+                if dot.label:
+                    dot.label.color = self.dot_control.label.color
+            for obj in self.grid.find_all_overlaps():
+                obj.color = self.overlap_color
 
     def draw_link_lines(self):
         line_color = "red"
+        self.line_items = []
         for i in range(len(self.dots) - 1):
             x1, y1 = self.dots[i].position
             x2, y2 = self.dots[i + 1].position
             x1_cpy, y1_cpy = x1 * self.scale, y1 * self.scale
             x2_cpy, y2_cpy = x2 * self.scale, y2 * self.scale
-            self.canvas.create_line(x1_cpy,
-                                    y1_cpy,
-                                    x2_cpy,
-                                    y2_cpy,
-                                    fill=line_color,
-                                    width=2)
+            item_id = self.canvas.create_line(x1_cpy,
+                                              y1_cpy,
+                                              x2_cpy,
+                                              y2_cpy,
+                                              fill=line_color,
+                                              width=2)
+            self.line_items.append(item_id)
+
+    def _update_adjacent_link_lines(self, index):
+        """
+        Moves only the two link-line segments attached to the dot at the
+        given index, keeping drags free of any full redraw.
+        """
+        if not self.link_dots_var.get() or not self.line_items:
+            return
+        for segment in (index - 1, index):
+            if 0 <= segment < len(self.line_items):
+                x1, y1 = self.dots[segment].position
+                x2, y2 = self.dots[segment + 1].position
+                self.canvas.coords(self.line_items[segment], x1 * self.scale,
+                                   y1 * self.scale, x2 * self.scale,
+                                   y2 * self.scale)
 
     def on_apply(self):
         canvas_image = self.generate_image()
@@ -307,32 +433,110 @@ class EditWindow(DisplayWindowBase):
             self.apply_callback(canvas_image, self.dots, self.dot_control)
         self.window.destroy()
 
+    def _dot_render_box(self, dot):
+        """
+        Returns the region covered by a dot and its label, padded for
+        antialiasing and the editing-only label offset.
+        """
+        x_dot, y_dot = dot.position
+        radius = dot.radius
+        box = [x_dot - radius, y_dot - radius, x_dot + radius, y_dot + radius]
+        if dot.label:
+            label_box = label_metrics.anchored_bbox(dot.label.position,
+                                                    dot.label.font,
+                                                    dot.label.text,
+                                                    dot.label.anchor,
+                                                    dot.label.font_path,
+                                                    dot.label.font_size)
+            box = [
+                min(box[0], label_box[0]),
+                min(box[1], label_box[1]),
+                max(box[2], label_box[2]),
+                max(box[3], label_box[3])
+            ]
+        margin = 4 + self.add_hoc_offset_y_label
+        return (box[0] - margin, box[1] - margin, box[2] + margin,
+                box[3] + margin)
+
+    def _mark_render_dirty(self, dot):
+        """
+        Accumulates the dot's current region into the dirty box used by
+        the incremental render in generate_image.
+        """
+        box = self._dot_render_box(dot)
+        if self._dirty_box is None:
+            self._dirty_box = box
+        else:
+            self._dirty_box = (min(self._dirty_box[0], box[0]),
+                               min(self._dirty_box[1], box[1]),
+                               max(self._dirty_box[2], box[2]),
+                               max(self._dirty_box[3], box[3]))
+
+    def _render_dot(self, draw, dot):
+        x_dot, y_dot = dot.position
+        radius = dot.radius
+        fill_color = dot.color
+        upper_left = (x_dot - radius, y_dot - radius)
+        bottom_right = (x_dot + radius, y_dot + radius)
+        draw.ellipse([upper_left, bottom_right], fill=fill_color)
+        if dot.label:
+            if dot.label.has_move:
+                # we need to remove the offset that isn't correct outside of edit window
+                dot.label.position = (dot.label.position[0],
+                                      dot.label.position[1] -
+                                      self.add_hoc_offset_y_label)
+                dot.label.has_move = False
+            x_label, y_label = dot.label.position
+            anchor_map = dot.label.anchor
+            draw.text((x_label, y_label),
+                      dot.label.text,
+                      font=dot.label.font,
+                      fill=dot.label.color,
+                      anchor=anchor_map)
+
     def generate_image(self):
-        image = Image.new("RGBA",
-                          (int(self.canvas_width), int(self.canvas_height)),
-                          (255, 255, 255, 0))
-        draw = ImageDraw.Draw(image)
-        for dot in self.dots:
-            x_dot, y_dot = dot.position
-            radius = dot.radius
-            fill_color = dot.color
-            upper_left = (x_dot - radius, y_dot - radius)
-            bottom_right = (x_dot + radius, y_dot + radius)
-            draw.ellipse([upper_left, bottom_right], fill=fill_color)
-            if dot.label:
-                if dot.label.has_move:
-                    # we need to remove the offset that isn't correct outside of edit window
-                    dot.label.position = (dot.label.position[0],
-                                          dot.label.position[1] -
-                                          self.add_hoc_offset_y_label)
-                x_label, y_label = dot.label.position
-                anchor_map = dot.label.anchor
-                draw.text((x_label, y_label),
-                          str(dot.dot_id),
-                          font=dot.label.font,
-                          fill=dot.label.color,
-                          anchor=anchor_map)
-        return image
+        if self._rendered_image is None or self._needs_full_render:
+            image = Image.new(
+                "RGBA", (int(self.canvas_width), int(self.canvas_height)),
+                (255, 255, 255, 0))
+            draw = ImageDraw.Draw(image)
+            for dot in self.dots:
+                self._render_dot(draw, dot)
+            self._rendered_image = image
+        elif self._dirty_box is not None:
+            # Clear only the edited region of the cached frame and
+            # redraw the dots touching it; untouched dots keep their
+            # already-rendered pixels. The region is grown until it
+            # fully covers every redrawn dot, so no dot is blended
+            # twice across the region edge.
+            region = self._dirty_box
+            while True:
+                to_draw = []
+                expanded = region
+                for dot in self.dots:
+                    box = self._dot_render_box(dot)
+                    if (box[2] < region[0] or box[0] > region[2]
+                            or box[3] < region[1] or box[1] > region[3]):
+                        continue
+                    to_draw.append(dot)
+                    expanded = (min(expanded[0], box[0]),
+                                min(expanded[1], box[1]),
+                                max(expanded[2], box[2]),
+                                max(expanded[3], box[3]))
+                if expanded == region:
+                    break
+                region = expanded
+            region = (max(0, int(region[0])), max(0, int(region[1])),
+                      min(int(self.canvas_width), int(region[2]) + 1),
+                      min(int(self.canvas_height), int(region[3]) + 1))
+            if region[0] < region[2] and region[1] < region[3]:
+                self._rendered_image.paste((255, 255, 255, 0), region)
+                draw = ImageDraw.Draw(self._rendered_image)
+                for dot in to_draw:
+                    self._render_dot(draw, dot)
+        self._needs_full_render = False
+        self._dirty_box = None
+        return self._rendered_image
 
     def on_cancel_main_button(self):
         popup = tk.Toplevel(self.window)
@@ -549,8 +753,9 @@ class EditWindow(DisplayWindowBase):
             self.redraw_canvas()
         else:
             self.apply_overlap_detection = True
-            # Reapply overlap detection colors
-            overlaps = self.grid.find_all_overlaps()
+            # Reapply overlap detection colors, recomputing only the cells
+            # touched since detection was last on
+            overlaps = self.grid.update_overlaps()
             for obj in overlaps:
                 obj.color = self.overlap_color
             self.redraw_canvas()
@@ -621,6 +826,7 @@ class EditWindow(DisplayWindowBase):
                 label_item_id = self.label_items[self.selected_dot_index]
                 self.canvas.coords(label_item_id, x, y)
         dot = self.dots[self.selected_dot_index]
+        self._update_adjacent_link_lines(self.selected_dot_index)
         self.grid.move_dot_and_label(dot)
         self._update_color_dot(
             dot, self.dot_items[self.selected_dot_index], label,
@@ -682,6 +888,8 @@ class EditWindow(DisplayWindowBase):
             self.dot_control.radius = new_radius
             for dot in self.dots:
                 dot.radius = new_radius
+            self._needs_full_render = True
+            self._journal({"op": "radius", "value": new_radius})
             self.redraw_canvas()
         except (ValueError, tk.TclError):
             messagebox.showerror(
@@ -697,13 +905,13 @@ class EditWindow(DisplayWindowBase):
             return
 
         # Reverse the dots and labels
+        self._needs_full_render = True
         self.dots.reverse()
 
         # Update the labels' text to reflect the new order
-        for idx in range(len(self.dots)):
-            new_idx = idx + 1
-            self.dots[idx].dot_id = new_idx
+        self._renumber_dots_from(0)
 
+        self._journal({"op": "reverse"})
         # Redraw the canvas to reflect the reversed order
         self.redraw_canvas()
 
@@ -719,6 +927,8 @@ class EditWindow(DisplayWindowBase):
             for dot in self.dots:
                 dot.label.font_size = new_font_size
                 dot.label.font = self.dot_control.label.font
+            self._needs_full_render = True
+            self._journal({"op": "font_size", "value": new_font_size})
             self.redraw_canvas()
         except (ValueError, tk.TclError, IOError):
             messagebox.showerror(
@@ -759,6 +969,7 @@ class EditWindow(DisplayWindowBase):
             new_pos_x = dot.position[0] + distance_from_dots
             new_pos_y = dot.position[1] + distance_from_dots
             label.position = (new_pos_x, new_pos_y)
+            self._needs_full_render = True
 
             self.redraw_canvas()
 
@@ -808,6 +1019,7 @@ class EditWindow(DisplayWindowBase):
             reordered_dots = self.dots[
                 selected_index:] + self.dots[:selected_index]
             self.dots = reordered_dots
+            self._needs_full_render = True
 
             # Update dot_id
             for idx in range(len(self.dots)):
@@ -850,11 +1062,10 @@ class EditWindow(DisplayWindowBase):
                               self.dot_control.label.font_path,
                               self.dot_control.label.font_size)
 
+            self._needs_full_render = True
             self.dots.insert(selected_index + 1, new_dot)
-
-            # Update IDs
-            for idx in range(selected_index + 2, len(self.dots)):
-                self.dots[idx].dot_id += 1
+            self._renumber_dots_from(selected_index + 2)
+            self._rebuild_grid()
 
             self.redraw_canvas()
 
@@ -876,9 +1087,9 @@ class EditWindow(DisplayWindowBase):
                 messagebox.showerror("Error", "Selected dot does not exist.")
                 return
 
-            # Update IDs
-            for idx in range(selected_index, len(self.dots)):
-                self.dots[idx].dot_id = idx + 1
+            self._needs_full_render = True
+            self._renumber_dots_from(selected_index)
+            self._rebuild_grid()
 
             self.redraw_canvas()
 
@@ -4,8 +4,8 @@ Help defined some canvas to display a simple image
 
 import tkinter as tk
 import platform
-from PIL import ImageTk
-from dot2dot.utils import resize_image
+from PIL import Image, ImageTk
+from dot2dot.image_pyramid import ImagePyramid
 
 
 class ImageCanvas:
@@ -32,7 +32,13 @@ class ImageCanvas:
         self.canvas.bind("<Double-1>", self.on_double_click)
         # Initialize image-related attributes
         self.image = None  # Original PIL Image
-        self.photo_image = None  # ImageTk.PhotoImage for Tkinter
+        self.pyramid = None  # Zoom pyramid over the loaded image
+        # One persistent viewport-sized PhotoImage, updated in place
+        # from a cropped pyramid view; pan/zoom never reallocates it
+        self.photo_image = None
+        self._frame = None  # Reusable PIL compositing buffer
+        self._image_item = None  # Canvas item holding photo_image
+        self.offset = None  # Image top-left in canvas coordinates
         self.scale = 1.0  # Current scale factor
         self.min_scale = 0.1  # Minimum zoom level
         self.max_scale = 5.0  # Maximum zoom level
@@ -48,7 +54,8 @@ class ImageCanvas:
 
     def on_resize(self, _):
         """
-        Repositions the placeholder text to keep it centered on the canvas.
+        Repositions the placeholder text to keep it centered on the
+        canvas and re-renders the viewport at its new size.
         """
         placeholder_text = self.canvas.find_withtag("placeholder_text")
         if placeholder_text:
@@ -56,23 +63,41 @@ class ImageCanvas:
             canvas_height = self.canvas.winfo_height()
             self.canvas.coords(placeholder_text, canvas_width / 2,
                                canvas_height / 2)
+        if self.image_loaded:
+            # Recenter so the fit-to-canvas scale stays meaningful
+            self.offset = None
+            self.display_image()
 
     def load_image(self, pil_image):
         """
         Loads a PIL Image into the canvas and resets zoom and pan.
         """
         self.image = pil_image
+        self.pyramid = ImagePyramid(pil_image)
         self.scale = 1.0
+        self.offset = None  # Recenter on the next render
         self.image_loaded = True
         self.canvas.delete("all")
+        self._image_item = None
         self.display_image()
         image_width, image_height = pil_image.size  # Assuming processed_image is a PIL Image
 
         return image_width, image_height
 
+    def _fit_scale(self, canvas_width, canvas_height):
+        """
+        Display scale: fit-to-canvas times the current zoom factor,
+        preserving the aspect ratio.
+        """
+        return min(canvas_width * self.scale / self.image.width,
+                   canvas_height * self.scale / self.image.height)
+
     def display_image(self):
         """
-        Displays the current image on the canvas with the current scale and pan offsets.
+        Renders the visible part of the image into the persistent
+        viewport PhotoImage. Only the on-screen region is cropped from
+        the nearest pyramid level and pasted in place, so panning and
+        zooming never allocate full-image buffers.
         """
         if self.image is None:
             return
@@ -80,19 +105,52 @@ class ImageCanvas:
         # Get current canvas size
         canvas_width = self.canvas.winfo_width()
         canvas_height = self.canvas.winfo_height()
+        if canvas_width < 2 or canvas_height < 2:
+            return
 
-        # Resize the image based on the current scale
-        resized_pil_image = resize_image(
-            self.image,
-            (int(canvas_width * self.scale), int(canvas_height * self.scale)))
-        self.photo_image = ImageTk.PhotoImage(resized_pil_image)
+        fit_scale = self._fit_scale(canvas_width, canvas_height)
+        display_width = self.image.width * fit_scale
+        display_height = self.image.height * fit_scale
 
-        # Center the image
-        self.canvas.delete("all")
-        self.canvas.create_image(canvas_width / 2,
-                                 canvas_height / 2,
-                                 image=self.photo_image,
-                                 anchor="center")
+        if self.offset is None:
+            # Center the image in the viewport
+            self.offset = ((canvas_width - display_width) / 2,
+                           (canvas_height - display_height) / 2)
+        offset_x, offset_y = self.offset
+
+        # The viewport buffers persist across frames and are only
+        # rebuilt when the canvas size changes
+        viewport_size = (canvas_width, canvas_height)
+        if self.photo_image is None or self._frame.size != viewport_size:
+            self._frame = Image.new("RGBA", viewport_size, (0, 0, 0, 0))
+            self.photo_image = ImageTk.PhotoImage("RGBA", viewport_size)
+            self._image_item = None
+        else:
+            # Clear the reusable compositing buffer in place
+            self._frame.paste((0, 0, 0, 0),
+                              (0, 0, canvas_width, canvas_height))
+
+        # Intersect the displayed image with the viewport, in canvas
+        # coordinates
+        visible_x0 = max(0.0, offset_x)
+        visible_y0 = max(0.0, offset_y)
+        visible_x1 = min(float(canvas_width), offset_x + display_width)
+        visible_y1 = min(float(canvas_height), offset_y + display_height)
+
+        if visible_x1 > visible_x0 and visible_y1 > visible_y0:
+            source_box = ((visible_x0 - offset_x) / fit_scale,
+                          (visible_y0 - offset_y) / fit_scale,
+                          (visible_x1 - offset_x) / fit_scale,
+                          (visible_y1 - offset_y) / fit_scale)
+            crop = self.pyramid.get_scaled_crop(source_box, fit_scale)
+            self._frame.paste(crop, (int(visible_x0), int(visible_y0)))
+
+        # In-place update of the one PhotoImage bound to the canvas item
+        self.photo_image.paste(self._frame)
+        if self._image_item is None or not self.canvas.find_withtag(
+                self._image_item):
+            self._image_item = self.canvas.create_image(
+                0, 0, image=self.photo_image, anchor="nw")
 
     def on_zoom(self, event):
         """
@@ -126,6 +184,16 @@ class ImageCanvas:
             new_scale = max(self.min_scale, min(self.max_scale, new_scale))
 
             if new_scale != self.scale:
+                # Keep the canvas center anchored while zooming
+                if self.offset is not None:
+                    canvas_width = self.canvas.winfo_width()
+                    canvas_height = self.canvas.winfo_height()
+                    ratio = new_scale / self.scale
+                    center_x = canvas_width / 2
+                    center_y = canvas_height / 2
+                    offset_x, offset_y = self.offset
+                    self.offset = (center_x - (center_x - offset_x) * ratio,
+                                   center_y - (center_y - offset_y) * ratio)
                 self.scale = new_scale
                 self.display_image()
 
@@ -151,8 +219,11 @@ class ImageCanvas:
         self._drag_data["x"] = event.x
         self._drag_data["y"] = event.y
 
-        # Move the image by the deltas
-        self.canvas.move("all", dx, dy)
+        # Shift the viewport and re-render the visible crop in place
+        if self.offset is not None:
+            offset_x, offset_y = self.offset
+            self.offset = (offset_x + dx, offset_y + dy)
+            self.display_image()
 
     def on_double_click(self, _):
         """
@@ -0,0 +1,89 @@
+"""
+Single-worker job scheduler for background processing in GUI windows.
+Each window owns one scheduler; submitting a new job cancels the running
+one (cooperatively, via its token) and replaces any job still waiting,
+so the latest parameters always win and abandoned recomputes stop early
+instead of racing each other on their own threads.
+"""
+
+import threading
+
+
+class CancellationToken:
+    """
+    Cooperative cancellation flag shared between a scheduler and the job
+    it is running. Jobs poll `cancelled` at cheap checkpoints and bail
+    out when it is set.
+    """
+
+    def __init__(self):
+        self._event = threading.Event()
+
+    def cancel(self):
+        self._event.set()
+
+    @property
+    def cancelled(self):
+        return self._event.is_set()
+
+
+class JobScheduler:
+    """
+    Runs jobs one at a time on a single daemon worker thread with
+    newest-request-wins coalescing: at most one job is pending, and
+    submitting a new one cancels both the pending and the running job.
+    """
+
+    def __init__(self, name="job-scheduler"):
+        self._condition = threading.Condition()
+        self._pending = None  # (func, args, kwargs, token)
+        self._current_token = None
+        self._worker = threading.Thread(target=self._run,
+                                        name=name,
+                                        daemon=True)
+        self._worker.start()
+
+    def submit(self, func, *args, **kwargs):
+        """
+        Schedules `func(*args, cancel_token=token, **kwargs)` on the
+        worker thread, superseding any pending job and requesting
+        cancellation of the running one.
+
+        Returns:
+        - The CancellationToken handed to the job.
+        """
+        token = CancellationToken()
+        with self._condition:
+            if self._pending is not None:
+                # Superseded before it even started
+                self._pending[3].cancel()
+            if self._current_token is not None:
+                self._current_token.cancel()
+            self._pending = (func, args, kwargs, token)
+            self._condition.notify()
+        return token
+
+    def cancel_all(self):
+        """Drops the pending job and cancels the running one."""
+        with self._condition:
+            if self._pending is not None:
+                self._pending[3].cancel()
+                self._pending = None
+            if self._current_token is not None:
+                self._current_token.cancel()
+
+    def _run(self):
+        while True:
+            with self._condition:
+                while self._pending is None:
+                    self._condition.wait()
+                func, args, kwargs, token = self._pending
+                self._pending = None
+                self._current_token = token
+            try:
+                func(*args, cancel_token=token, **kwargs)
+            except Exception as error:
+                print(f"Background job failed: {error}")
+            finally:
+                with self._condition:
+                    self._current_token = None
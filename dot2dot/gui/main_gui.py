@@ -10,6 +10,8 @@ from tkinter import filedialog, messagebox, ttk
 import cv2
 import numpy as np
 from PIL import Image, ImageTk
+from dot2dot import profiling
+from dot2dot.multi_contour import process_all_contours
 from dot2dot.processing import process_single_image
 from dot2dot.gui.tooltip import Tooltip
 from dot2dot.gui.edit_window import EditWindow
@@ -19,10 +21,13 @@ from dot2dot.gui.disposition_dots_window import DispositionDotsWindow
 from dot2dot.gui.shape_vis_window import ShapeVisWindow
 from dot2dot.gui.popup_2_buttons import Popup2Buttons
 from dot2dot.gui.menu_bar import MenuBar
+from dot2dot.gui.job_scheduler import JobScheduler
 from dot2dot.dots_config import DotsConfig
 from dot2dot.dots_saver import DotsSaver
+from dot2dot.autosave import AutosaveService, pending_recovery_path
+from metadata import read_metadata
 from dot2dot.gui.image_canvas import ImageCanvas
-from dot2dot.utils import get_base_directory, image_to_pil_rgb, rgba_to_hex, load_image, resize_image
+from dot2dot.utils import get_base_directory, image_to_pil_rgb, rgba_to_hex, load_image
 from dot2dot.gui.utilities_gui import set_icon
 from dot2dot.gui.utilities_gui import set_screen_choice
 
@@ -51,8 +56,17 @@ class DotToDotGUI:
         # it will be updated when clicking on process
         self.dots_config = DotsConfig.default_dots_config(self.config)
         self.processed_dots = []
+        self._profile_parts = []
+        self._input_image_path_loaded = None
         self.dots_saver = DotsSaver(self.root, self, self.config)
+        # Single worker for process requests: a new request supersedes
+        # and cancels the previous one instead of piling up threads
+        self.job_scheduler = JobScheduler(name="main-gui-process")
+        # Background crash-recovery writer; snapshots and journal
+        # entries are written off the GUI thread
+        self.autosave = AutosaveService(self._autosave_state)
         self.create_widgets()
+        self._offer_autosave_recovery()
         # Bind the close event to a custom handler
         self.root.protocol("WM_DELETE_WINDOW", self.on_close)
 
@@ -68,11 +82,13 @@ class DotToDotGUI:
                 "You have unsaved changes. Do you want to exit without saving?",
             )
             if response:  # User chose 'Yes'
+                self.autosave.shutdown()
                 self.root.destroy()
             elif response is None:  # User chose 'Cancel'
                 return
         else:
             # No unsaved changes, proceed with closing
+            self.autosave.shutdown()
             self.root.destroy()
 
     def maximize_window(self):
@@ -165,6 +181,15 @@ class DotToDotGUI:
         self.progress.grid(row=5, column=0, padx=5, pady=(0, 10), sticky="ew")
         Tooltip(self.progress, "Indicates the processing progress.")
 
+        # Live per-stage timings shown while a process run is underway
+        self.profile_status = tk.StringVar(value="")
+        profile_label = ttk.Label(control_frame,
+                                  textvariable=self.profile_status,
+                                  anchor="w")
+        profile_label.grid(row=6, column=0, padx=5, pady=(0, 10), sticky="ew")
+        Tooltip(profile_label,
+                "Time spent in each processing stage of the last run.")
+
         # Right Frame for Image Previews (Input and Output Side by Side)
         preview_frame = ttk.Frame(self.root)
         preview_frame.grid(row=0, column=1, padx=10, pady=10, sticky="nsew")
@@ -248,7 +273,7 @@ class DotToDotGUI:
 
     def load_input_threaded(self):
         file_path = filedialog.askopenfilename(filetypes=[
-            ("All files", "*.*"), ("Dot2Dot files", "*.d2d"),
+            ("All files", "*.*"), ("Dot2Dot files", "*.d2d;*.d2d.json"),
             ("PNG files", "*.png"), ("JPEG files", "*.jpg;*.jpeg")
         ],
                                                title="Load Dots Data or Image")
@@ -274,6 +299,46 @@ class DotToDotGUI:
             # stop the progress bar
             self.root.after(0, lambda: self.set_processing_state(False))
 
+    def _autosave_state(self):
+        """
+        Provides the state snapshotted by the autosave writer. Returns
+        None while there is nothing worth protecting yet.
+        """
+        if not self.processed_dots:
+            return None
+        return (self.processed_dots,
+                self.dots_saver._dots_config_to_dict(self.dots_config),
+                read_metadata())
+
+    def _offer_autosave_recovery(self):
+        """
+        Offers to restore the autosaved session left behind by a crash.
+        """
+        recovery_path = pending_recovery_path()
+        if not recovery_path:
+            return
+        if not messagebox.askyesno(
+                "Autosave Recovery",
+                "An autosaved session from a previous run was found.\n"
+                "Do you want to restore it?"):
+            return
+        self.root.after(0, lambda: self.set_processing_state(True))
+        threading.Thread(target=self._load_recovery,
+                         args=(recovery_path, ),
+                         daemon=True).start()
+
+    def _load_recovery(self, recovery_path):
+        try:
+            self.dots_saver.load_input(recovery_path)
+            # The recovered state belongs to no user-chosen file yet
+            self.dots_saver.save_path = None
+            self.needs_save = True
+        except Exception as errorGUI:
+            stack_trace = traceback.format_exc()
+            self.root.after(0, lambda: ErrorWindow(self.root, stack_trace))
+        finally:
+            self.root.after(0, lambda: self.set_processing_state(False))
+
     def double_click_output_canvas(self):
         if self.processed_image is None:
             self.process_threaded()
@@ -357,9 +422,9 @@ class DotToDotGUI:
             self._start_process()
 
     def _start_process(self):
-        threading.Thread(target=self.process, daemon=True).start()
+        self.job_scheduler.submit(self.process)
 
-    def process(self):
+    def process(self, cancel_token=None):
         start_time = time.time()
         if not os.path.isfile(self.dots_config.input_path):
             messagebox.showwarning(
@@ -373,9 +438,20 @@ class DotToDotGUI:
 
         try:
             self.needs_save = True
+            # Live per-stage timings in the panel under the progress bar.
+            # Memory tracking stays off: tracemalloc would slow the
+            # whole interactive session, not just this run.
+            self._profile_parts = []
+            profiler = profiling.StageProfiler(track_memory=False)
+            profiler.add_listener(self._on_stage_profiled)
             # Processing a single image
-            self.processed_image, self.combined_image, elapsed_time, self.processed_dots, have_multiple_contours = process_single_image(
-                self.dots_config)
+            result = process_single_image(self.dots_config,
+                                          cancel_token=cancel_token,
+                                          profiler=profiler)
+            if result is None:
+                # Canceled between stages because a newer request won
+                return
+            self.processed_image, self.combined_image, elapsed_time, self.processed_dots, have_multiple_contours = result
             if have_multiple_contours:
                 self.handle_multiple_contours()
 
@@ -383,6 +459,7 @@ class DotToDotGUI:
             end_time = time.time()
             elapsed_time = end_time - start_time
             self.set_output_image()
+            self.autosave.mark_dirty()
             print(f"Processing completed in {elapsed_time:.2f} seconds")
 
         except Exception as errorGUI:
@@ -394,6 +471,41 @@ class DotToDotGUI:
             # Re-enable the process button and stop the progress bar
             self.root.after(0, lambda: self.set_processing_state(False))
 
+    def process_multi_contours(self, cancel_token=None):
+        """
+        Reruns the processing over every shape of the image in parallel
+        worker processes, merging the results with per-shape numbering.
+        """
+        self.root.after(0, lambda: self.set_processing_state(True))
+        try:
+            self.needs_save = True
+            result = process_all_contours(self.dots_config,
+                                          cancel_token=cancel_token)
+            if result is None:
+                # Canceled between stages because a newer request won
+                return
+            self.processed_image, self.combined_image, elapsed_time, \
+                self.processed_dots, _ = result
+            self.set_output_image()
+            self.autosave.mark_dirty()
+            print(f"Multi-shape processing completed in "
+                  f"{elapsed_time:.2f} seconds")
+        except Exception as errorGUI:
+            stack_trace = traceback.format_exc()
+            self.root.after(0, lambda: ErrorWindow(self.root, stack_trace))
+        finally:
+            self.root.after(0, lambda: self.set_processing_state(False))
+
+    def _on_stage_profiled(self, record):
+        """
+        Profiler listener: appends the finished stage timing to the
+        panel under the progress bar, marshalled to the GUI thread.
+        """
+        self._profile_parts.append(
+            f"{record['name']} {record['seconds'] * 1000.0:.0f} ms")
+        text = " | ".join(self._profile_parts)
+        self.root.after(0, lambda: self.profile_status.set(text))
+
     def show_warning_contours(self, contours_window):
         if messagebox.showwarning(
                 "Warning",
@@ -404,6 +516,16 @@ class DotToDotGUI:
 
     def handle_multiple_contours(self):
 
+        # Offer to rerun on every shape at once before falling back to
+        # the largest-contour warning
+        if messagebox.askyesno(
+                "Multiple Shapes",
+                "Several shapes were found in the image.\n"
+                "Process all of them in one pass with per-shape numbering "
+                "instead of only the largest one?"):
+            self.job_scheduler.submit(self.process_multi_contours)
+            return
+
         # Open the MultipleContoursWindow to handle multiple contours
         contours_window = MultipleContoursWindow(self.root,
                                                  self.dots_config.input_path,
@@ -420,6 +542,7 @@ class DotToDotGUI:
     def set_processing_state(self, is_processing):
         if is_processing:
             self.root.config(cursor="wait")
+            self.profile_status.set("")
             self.progress.start()
             # Disable interactive widgets to prevent user actions during processing
             for child in self.root.winfo_children():
@@ -486,14 +609,18 @@ class DotToDotGUI:
         Updates the displayed image when the canvas is resized.
         """
         if os.path.isfile(self.dots_config.input_path):
+            # Plain canvas resizes reuse the loaded image and its zoom
+            # pyramid; only a path change reloads from disk
+            if (self.input_canvas.image_loaded
+                    and self._input_image_path_loaded
+                    == self.dots_config.input_path):
+                self.input_canvas.display_image()
+                return
             self.original_input_image = load_image(self.dots_config.input_path)
             if self.original_input_image:
-                target_size = (self.input_canvas.canvas.winfo_width(),
-                               self.input_canvas.canvas.winfo_height())
-                resized_pil_image = resize_image(self.original_input_image,
-                                                 target_size)
                 self.image_width, self.image_height = self.input_canvas.load_image(
                     self.original_input_image)
+                self._input_image_path_loaded = self.dots_config.input_path
         else:
             self.clear_input_image()
 
@@ -511,6 +638,8 @@ class DotToDotGUI:
         self.output_canvas.load_image(edited_image)
         self.processed_dots = updated_dots
         self.dots_config.dot_control = dot_control
+        # The applied state supersedes the edit journal
+        self.autosave.mark_dirty()
 
     def open_edit_window(self):
         if self.processed_image is None:
@@ -527,7 +656,9 @@ class DotToDotGUI:
                    image_height=self.image_height,
                    input_image=self.original_input_image,
                    config=self.config,
-                   apply_callback=self.apply_changes)
+                   apply_callback=self.apply_changes,
+                   autosave=self.autosave,
+                   baseline_image=self.original_output_image)
 
     def open_shape_vis_window(self):
         """
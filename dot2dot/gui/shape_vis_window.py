@@ -5,11 +5,12 @@ from tkinter import ttk, messagebox
 from PIL import Image, ImageTk
 import numpy as np
 from dot2dot.image_discretization import ImageDiscretization
-import threading
 from dot2dot.gui.tooltip import Tooltip
+from dot2dot.preview import get_preview_input
 from dot2dot.utils import filter_close_points
 from dot2dot.gui.utilities_gui import set_icon
 from dot2dot.gui.display_window_base import DisplayWindowBase  # Corrected import
+from dot2dot.gui.job_scheduler import JobScheduler
 import platform
 
 
@@ -59,6 +60,10 @@ class ShapeVisWindow(DisplayWindowBase):
         self.filtered_points = []
         self.min_distance = 20  # Minimum distance for point filtering
 
+        # Single worker for recomputes: switching mode again cancels the
+        # recompute in flight so only the latest selection is drawn
+        self.job_scheduler = JobScheduler(name="shape-vis-process")
+
         # Create controls for opacity and shape detection
         self.create_controls()
 
@@ -76,19 +81,11 @@ class ShapeVisWindow(DisplayWindowBase):
                                 font=("Helvetica", 24, "bold"),
                                 fill="gray")
 
-        def process_in_thread():
+        def process_in_thread(cancel_token=None):
             try:
                 # Heavy initialization
-                self.image_discretization = ImageDiscretization(
-                    self.input_path, self.shape_detection.lower(),
-                    self.threshold_binary, False)
-                self.dots = self.image_discretization.discretize_image()
-                self.contour = np.array([dot.position for dot in self.dots],
-                                        dtype=np.int32)
-
-                points = [(point[0], point[1]) for point in self.contour]
-                self.filtered_points = filter_close_points(
-                    points, self.min_distance)
+                if not self.update_contour(cancel_token):
+                    return
 
                 # Once processed, schedule canvas redraw on the main thread
                 self.window.after(0, self.redraw_canvas)
@@ -102,8 +99,8 @@ class ShapeVisWindow(DisplayWindowBase):
                 # Stop progress bar after processing
                 self.window.after(0, lambda: self.set_loading_state(False))
 
-        # Start the processing thread
-        threading.Thread(target=process_in_thread, daemon=True).start()
+        # Hand the processing to the window's worker
+        self.job_scheduler.submit(process_in_thread)
 
     def create_controls(self):
         """
@@ -172,31 +169,52 @@ class ShapeVisWindow(DisplayWindowBase):
         self.shape_detection = self.shape_mode_var.get()
         self.set_loading_state(True)  # Start loading state
 
-        # Start a new thread to run process_and_redraw
-        threading.Thread(target=self.process_and_redraw_threaded,
-                         daemon=True).start()
+        # Schedule the recompute, superseding any recompute in flight
+        self.job_scheduler.submit(self.process_and_redraw_threaded)
 
-    def process_and_redraw_threaded(self):
-        """Run the processing and redraw in a separate thread."""
-        self.update_contour(
-        )  # Process the contour based on the new shape mode
+    def process_and_redraw_threaded(self, cancel_token=None):
+        """Run the processing and redraw on the worker thread."""
+        # Process the contour based on the new shape mode
+        if not self.update_contour(cancel_token):
+            # Superseded by a newer mode change; let that one redraw
+            return
 
         # Schedule the redraw and loading state reset on the main thread
         self.window.after(0, self.redraw_canvas)
         self.window.after(0, lambda: self.set_loading_state(False))
 
-    def update_contour(self):
-        """Update the contour based on the current shape detection mode."""
-        self.image_discretization = ImageDiscretization(
-            self.input_path, self.shape_detection.lower(),
-            self.threshold_binary, False)
-        self.dots = self.image_discretization.discretize_image()
-        self.contour = np.array([dot.position for dot in self.dots],
-                                dtype=np.int32)
-
-        points = [(point[0], point[1])
-                  for point in self.contour]  # Simplify to list of tuples
-        self.filtered_points = filter_close_points(points, self.min_distance)
+    def update_contour(self, cancel_token=None):
+        """
+        Update the contour based on the current shape detection mode.
+        Returns False when the job was canceled between stages.
+        """
+        # Interactive recomputes run on a bounded-size preview of the
+        # image; the resulting points are scaled back to full resolution
+        # for display
+        preview_path, preview_scale = get_preview_input(self.input_path)
+        image_discretization = ImageDiscretization(
+            preview_path, self.shape_detection.lower(), self.threshold_binary,
+            False)
+        dots = image_discretization.discretize_image()
+
+        if cancel_token is not None and cancel_token.cancelled:
+            return False
+
+        contour = np.array([dot.position for dot in dots], dtype=np.int32)
+        if preview_scale != 1.0:
+            contour = np.rint(contour * preview_scale).astype(np.int32)
+
+        # filter_close_points consumes the (N, 2) array directly
+        filtered_points = filter_close_points(contour, self.min_distance)
+
+        if cancel_token is not None and cancel_token.cancelled:
+            return False
+
+        self.image_discretization = image_discretization
+        self.dots = dots
+        self.contour = contour
+        self.filtered_points = filtered_points
+        return True
 
     def draw_contour(self):
         """
@@ -2,11 +2,121 @@
 This module defined the label and create an image from the list of dots
 """
 
-from typing import List, Tuple
+import os
+import random
+import time
+from collections import defaultdict
+from typing import List, Optional, Tuple
 import numpy as np
 from PIL import Image, ImageDraw
+from dot2dot import label_metrics
 from dot2dot.dot import Dot
 
+# Prepared background layers (loaded, resized, opacity-applied) keyed by
+# (path, mtime, size, opacity). EditWindow.generate_image and
+# DotsSaver.redraw_image recomposite the same background over and over,
+# so regeneration costs one alpha-composite instead of a disk
+# round-trip plus a full-resolution resize.
+_background_cache = {}
+_BACKGROUND_CACHE_LIMIT = 4
+
+
+def get_background_layer(input_path, size, opacity=0.1):
+    """
+    Returns the faded background layer for the given input image,
+    resized to `size` with its alpha scaled by `opacity`, reusing the
+    cached layer when the file has not changed.
+
+    Parameters:
+    - input_path: Path of the background image.
+    - size: (width, height) of the produced layer.
+    - opacity: Alpha multiplier applied to the image.
+
+    Returns:
+        Image.Image: RGBA background layer (do not draw on it directly).
+    """
+    try:
+        mtime = os.path.getmtime(input_path)
+    except OSError:
+        mtime = None
+    key = (os.path.abspath(input_path), mtime, tuple(size),
+           round(float(opacity), 4))
+    layer = _background_cache.get(key)
+    if layer is None:
+        input_image = Image.open(input_path).convert("RGBA")
+        input_image = input_image.resize(tuple(size))
+        input_image_np = np.array(input_image)
+        input_image_np[..., 3] = (input_image_np[..., 3] *
+                                  opacity).astype(np.uint8)
+        layer = Image.fromarray(input_image_np)
+        if len(_background_cache) >= _BACKGROUND_CACHE_LIMIT:
+            # Drop the oldest entry; a handful of layers is plenty
+            _background_cache.pop(next(iter(_background_cache)))
+        _background_cache[key] = layer
+    return layer
+
+
+class BoxGrid:
+    """
+    Spatial hash of axis-aligned boxes used during label placement, so a
+    candidate box is only tested against the boxes sharing its cells
+    instead of every occupied box in the image.
+    """
+
+    def __init__(self, cell_size):
+        self.cell_size = max(1, cell_size)
+        self.cells = defaultdict(list)
+
+    def _cell_span(self, box):
+        col_min = int(box[0] // self.cell_size)
+        row_min = int(box[1] // self.cell_size)
+        col_max = int(box[2] // self.cell_size)
+        row_max = int(box[3] // self.cell_size)
+        return row_min, row_max, col_min, col_max
+
+    def add(self, box, payload=None):
+        """
+        Registers a box (with an optional payload) in every cell it spans.
+        """
+        row_min, row_max, col_min, col_max = self._cell_span(box)
+        for row in range(row_min, row_max + 1):
+            for col in range(col_min, col_max + 1):
+                self.cells[(row, col)].append((box, payload))
+
+    def remove(self, box, payload=None):
+        """
+        Removes a previously added box/payload pair from the cells it spans.
+        """
+        row_min, row_max, col_min, col_max = self._cell_span(box)
+        entry = (box, payload)
+        for row in range(row_min, row_max + 1):
+            for col in range(col_min, col_max + 1):
+                cell = self.cells.get((row, col))
+                if cell and entry in cell:
+                    cell.remove(entry)
+
+    def query(self, box):
+        """
+        Yields the (box, payload) pairs intersecting the given box,
+        visiting only the cells the box spans. A pair spanning several of
+        those cells is yielded once per cell.
+        """
+        row_min, row_max, col_min, col_max = self._cell_span(box)
+        for row in range(row_min, row_max + 1):
+            for col in range(col_min, col_max + 1):
+                for other, payload in self.cells.get((row, col), ()):
+                    if not (box[2] < other[0] or box[0] > other[2]
+                            or box[3] < other[1] or box[1] > other[3]):
+                        yield other, payload
+
+    def overlaps(self, box):
+        """
+        Checks whether the box intersects any registered box.
+        """
+        for _ in self.query(box):
+            return True
+        return False
+
 
 class ImageCreation:
     """
@@ -18,9 +128,26 @@ class ImageCreation:
                  dots: List[Dot],
                  dot_control: Dot,
                  debug: bool = False,
-                 reset_label: bool = True):
+                 reset_label: bool = True,
+                 placement_cell_size: Optional[int] = None,
+                 placement_time_budget: float = 0.0,
+                 shape_starts: Optional[List[int]] = None):
         """
         Initializes the ImageCreation instance with the given parameters.
+
+        placement_cell_size is the quality/speed knob of the label
+        placement index: smaller cells test fewer boxes per candidate but
+        cost more bookkeeping. By default it is derived from the dot
+        radius and font size.
+
+        placement_time_budget, in seconds, bounds an optional global
+        optimization pass run when the greedy placement leaves labels
+        unplaced; 0 (the default) disables it.
+
+        shape_starts lists the indices in `dots` where a new shape
+        begins. Displayed label numbers restart at 1 on each of those
+        indices and no connecting line is drawn across them, while
+        dot_id stays globally unique.
         """
         self.image_size = image_size
         self.dots = dots
@@ -28,6 +155,9 @@ class ImageCreation:
         self.font_path = dot_control.label.font_path
         self.font_size = dot_control.label.font_size
         self.font_color = dot_control.label.color
+        self.placement_cell_size = placement_cell_size
+        self.placement_time_budget = placement_time_budget
+        self.shape_starts = sorted(set(shape_starts or []))
 
         self.debug = debug
 
@@ -38,6 +168,16 @@ class ImageCreation:
                 dot.color = dot_control.color
                 dot.set_label(self.font_color, self.font_path, self.font_size)
 
+        if self.shape_starts:
+            # Per-shape display numbering on top of the global dot ids
+            starts = set(self.shape_starts)
+            shape_start = 0
+            for index, dot in enumerate(self.dots):
+                if index in starts:
+                    shape_start = index
+                if dot.label is not None:
+                    dot.label.text = str(index - shape_start + 1)
+
     def draw_points_on_image(
             self,
             input_path,
@@ -86,24 +226,22 @@ class ImageCreation:
         Returns:
             np.ndarray: Image with the input image as background and red lines connecting dots.
         """
-        # Load the input image
-        input_image = Image.open(input_path).convert("RGBA")
-        input_image = input_image.resize(
-            (self.image_size[1], self.image_size[0]))
-        input_image_np = np.array(input_image)
-
-        # Adjust the opacity of the input image
-        input_image_np[...,
-                       3] = (input_image_np[..., 3] * 0.1).astype(np.uint8)
-        input_image_with_opacity = Image.fromarray(input_image_np)
+        # Fetch the prepared background layer (loaded, resized and
+        # faded once, then cached by path/size/opacity)
+        input_image_with_opacity = get_background_layer(
+            input_path, (self.image_size[1], self.image_size[0]))
 
         # Overlay the final image on top of the input image with opacity
         combined_image = Image.alpha_composite(input_image_with_opacity,
                                                final_image)
         draw_combined = ImageDraw.Draw(combined_image)
 
-        # Draw red lines connecting each successive dot
+        # Draw red lines connecting each successive dot, without joining
+        # the last dot of one shape to the first of the next
+        shape_starts = set(self.shape_starts)
         for i in range(1, len(self.dots)):
+            if i in shape_starts:
+                continue
             previous_dot = self.dots[i - 1]
             current_dot = self.dots[i]
             draw_combined.line([previous_dot.position, current_dot.position],
@@ -179,10 +317,6 @@ class ImageCreation:
             - List of indices of dots where no suitable label position was found.
         """
 
-        def does_overlap(box1, box2):
-            return not (box1[2] < box2[0] or box1[0] > box2[2]
-                        or box1[3] < box2[1] or box1[1] > box2[3])
-
         def is_within_bounds(box, image_size):
             return (0 <= box[0] <= image_size[1]
                     and 0 <= box[1] <= image_size[0]
@@ -190,16 +324,21 @@ class ImageCreation:
                     and 0 <= box[3] <= image_size[0])
 
         image_size = self.image_size
-        occupied_boxes = []  # Track occupied areas (dots + labels)
         invalid_indices = []  # Indices of dots with no valid label positions
 
+        # Spatial index of occupied areas (dots + placed labels): each
+        # candidate only tests the boxes sharing its cells
+        cell_size = self.placement_cell_size or int(
+            4 * max(self.radius, self.font_size))
+        occupied_boxes = BoxGrid(cell_size)
+
         # Precompute the bounding boxes of all dots
         for dot in self.dots:
-            dot_box = [
-                dot.position[0] - dot.radius, dot.position[1] - dot.radius,
-                dot.position[0] + dot.radius, dot.position[1] + dot.radius
-            ]
-            occupied_boxes.append(dot_box)
+            dot_box = (dot.position[0] - dot.radius,
+                       dot.position[1] - dot.radius,
+                       dot.position[0] + dot.radius,
+                       dot.position[1] + dot.radius)
+            occupied_boxes.add(dot_box)
 
         for idx, dot in enumerate(self.dots):
             valid_position_found = False
@@ -216,14 +355,14 @@ class ImageCreation:
                 pos = pos_data["position"]
                 anchor = pos_data["anchor"]
 
-                # Compute the bounding box for the label at the current position
-                label_box = draw_pil.textbbox(pos, str(dot.dot_id),
-                                              dot.label.font, anchor)
+                # Compute the bounding box for the label at the current
+                # position from the cached metrics (no re-shaping)
+                label_box = label_metrics.anchored_bbox(
+                    pos, dot.label.font, dot.label.text, anchor,
+                    dot.label.font_path, dot.label.font_size)
 
                 # Check if this position is valid
-                overlaps = any(
-                    does_overlap(label_box, occupied_box)
-                    for occupied_box in occupied_boxes)
+                overlaps = occupied_boxes.overlaps(label_box)
                 within_bounds = is_within_bounds(label_box, image_size)
 
                 if not overlaps and within_bounds:
@@ -231,7 +370,7 @@ class ImageCreation:
                     dot.label.position = pos
                     dot.label.anchor = anchor
                     # Add the label box to occupied boxes
-                    occupied_boxes.append(label_box)
+                    occupied_boxes.add(label_box)
                     dot.overlap_other_dots = False  # Mark as not overlapping
                     valid_position_found = True
                     break
@@ -242,8 +381,144 @@ class ImageCreation:
                 dot.label.color = (255, 0, 0, 255)  # Mark label color as blue
                 dot.overlap_other_dots = True  # Mark as overlapping
 
+        # Optionally spend a bounded amount of extra CPU to resolve the
+        # labels the greedy first-fit could not place
+        if invalid_indices and self.placement_time_budget > 0:
+            invalid_indices = self._optimize_label_positions()
+
         return invalid_indices
 
+    def _optimize_label_positions(self) -> List[int]:
+        """
+        Global optimization pass over the candidate anchors of every
+        label, bounded by self.placement_time_budget seconds. A simulated
+        annealing style local search jointly reassigns conflicted labels
+        (and their neighbors) among their candidate positions, which
+        often frees positions the greedy first-fit painted red.
+
+        Returns:
+            - List of indices of dots that still have no valid position.
+        """
+        deadline = time.time() + self.placement_time_budget
+        image_size = self.image_size
+
+        def in_bounds(box):
+            return (0 <= box[0] <= image_size[1]
+                    and 0 <= box[1] <= image_size[0]
+                    and 0 <= box[2] <= image_size[1]
+                    and 0 <= box[3] <= image_size[0])
+
+        cell_size = self.placement_cell_size or int(
+            4 * max(self.radius, self.font_size))
+
+        # Static index of the dot disks
+        dot_grid = BoxGrid(cell_size)
+        for dot in self.dots:
+            dot_grid.add((dot.position[0] - dot.radius,
+                          dot.position[1] - dot.radius,
+                          dot.position[0] + dot.radius,
+                          dot.position[1] + dot.radius))
+
+        # Candidate (position, anchor, box) triplets and current choices
+        candidates = []
+        chosen = []
+        for dot in self.dots:
+            boxes = []
+            for pos_data in dot.label.possible_position:
+                box = label_metrics.anchored_bbox(pos_data["position"],
+                                                  dot.label.font,
+                                                  dot.label.text,
+                                                  pos_data["anchor"],
+                                                  self.font_path,
+                                                  self.font_size)
+                boxes.append((pos_data["position"], pos_data["anchor"], box))
+            candidates.append(boxes)
+            current = 0
+            for k, (pos, anchor, _) in enumerate(boxes):
+                if dot.label.position == pos and dot.label.anchor == anchor:
+                    current = k
+                    break
+            chosen.append(current)
+
+        # Dynamic index of the currently chosen label boxes
+        label_grid = BoxGrid(cell_size)
+        for index, boxes in enumerate(candidates):
+            if boxes:
+                label_grid.add(boxes[chosen[index]][2], index)
+
+        def conflicts(index, box):
+            count = 0
+            if not in_bounds(box):
+                count += 1
+            if dot_grid.overlaps(box):
+                count += 1
+            seen = set()
+            for _, payload in label_grid.query(box):
+                if payload != index and payload not in seen:
+                    seen.add(payload)
+                    count += 1
+            return count
+
+        conflicted = set()
+        for index, boxes in enumerate(candidates):
+            if boxes and conflicts(index, boxes[chosen[index]][2]) > 0:
+                conflicted.add(index)
+
+        total_budget = self.placement_time_budget
+        while conflicted and time.time() < deadline:
+            index = random.choice(tuple(conflicted))
+            boxes = candidates[index]
+            old_box = boxes[chosen[index]][2]
+            label_grid.remove(old_box, index)
+
+            # Cooling: the chance of a random (uphill) move shrinks as the
+            # budget runs out
+            remaining = max(0.0, deadline - time.time()) / total_budget
+            if random.random() < max(0.05, 0.3 * remaining):
+                choice = random.randrange(len(boxes))
+            else:
+                choice = min(range(len(boxes)),
+                             key=lambda k: conflicts(index, boxes[k][2]))
+            chosen[index] = choice
+            new_box = boxes[choice][2]
+            label_grid.add(new_box, index)
+
+            # Re-examine this label and every label near its old or new box
+            touched = {index}
+            for _, payload in label_grid.query(old_box):
+                touched.add(payload)
+            for _, payload in label_grid.query(new_box):
+                touched.add(payload)
+            for other in touched:
+                if not candidates[other]:
+                    continue
+                if conflicts(other, candidates[other][chosen[other]][2]) > 0:
+                    conflicted.add(other)
+                else:
+                    conflicted.discard(other)
+
+        # Apply the final assignment
+        still_invalid = []
+        for index, dot in enumerate(self.dots):
+            if not candidates[index]:
+                continue
+            pos, anchor, box = candidates[index][chosen[index]]
+            dot.label.position = pos
+            dot.label.anchor = anchor
+            if conflicts(index, box) > 0:
+                still_invalid.append(index)
+                dot.label.color = (255, 0, 0, 255)
+                dot.overlap_other_dots = True
+            else:
+                dot.label.color = self.font_color
+                dot.overlap_other_dots = False
+
+        if self.debug:
+            print(f"Label optimization: {len(still_invalid)} unplaced "
+                  f"labels left after the time-budgeted pass.")
+
+        return still_invalid
+
     def _draw_dots_and_labels(self, image: Image.Image) -> Image.Image:
         """
         Draws dots and labels on the main image using PIL.
@@ -273,7 +548,7 @@ class ImageCreation:
         for dot in self.dots:
             draw_pil.text(
                 dot.label.position,
-                str(dot.dot_id),
+                dot.label.text,
                 font=dot.label.font,
                 fill=dot.label.color,
                 anchor=dot.label.anchor,
@@ -3,36 +3,98 @@ This module handles the discretization in points of the image.
 It takes as input an image and returns a set of points that will be transformed in dots.
 """
 
+import time
 import numpy as np
 import cv2
 import cv2.ximgproc
 from dot2dot.utils import resize_for_debug, display_with_opencv
 from dot2dot.dot import Dot
+from dot2dot import discretization_cache
+
+try:
+    from numba import njit
+    NUMBA_AVAILABLE = True
+except ImportError:
+    # Fallback: run the kernels as plain Python when Numba is not installed.
+    NUMBA_AVAILABLE = False
+
+    def njit(*args, **kwargs):
+
+        def decorator(func):
+            return func
+
+        if len(args) == 1 and callable(args[0]):
+            return args[0]
+        return decorator
+
+
+# Result of the one-time OpenCL capability probe (None = not probed yet)
+_opencl_available = None
+
+
+def use_opencl():
+    """
+    Probes once whether OpenCL acceleration is usable and enables it.
+    A small smoke test catches platforms where cv2.ocl.haveOpenCL() is
+    True but the driver is broken; in that case we fall back to CPU Mats.
+    """
+    global _opencl_available
+    if _opencl_available is None:
+        try:
+            _opencl_available = bool(cv2.ocl.haveOpenCL())
+            if _opencl_available:
+                cv2.ocl.setUseOpenCL(True)
+                probe = cv2.UMat(np.zeros((8, 8), dtype=np.uint8))
+                cv2.threshold(probe, 0, 255, cv2.THRESH_BINARY)
+        except cv2.error:
+            _opencl_available = False
+        if not _opencl_available:
+            print("OpenCL not available, running the image pipeline on CPU.")
+    return _opencl_available
+
+
+def _as_numpy(mat):
+    """Downloads a UMat back to a numpy array; numpy arrays pass through."""
+    if isinstance(mat, cv2.UMat):
+        return mat.get()
+    return mat
+
+
+def count_skeleton_neighbors(skeleton):
+    """
+    Counts, for every pixel, how many of its 8 neighbors belong to the
+    skeleton. The count is computed in a single vectorized convolution pass
+    instead of a per-pixel Python scan.
+    """
+    mask = (skeleton > 0).astype(np.uint8)
+    kernel = np.array([[1, 1, 1], [1, 0, 1], [1, 1, 1]], dtype=np.uint8)
+    return cv2.filter2D(mask, cv2.CV_8U, kernel,
+                        borderType=cv2.BORDER_CONSTANT)
+
+
+def find_skeleton_nodes(skeleton):
+    """
+    Finds all endpoints (exactly one neighbor) and junction points (three or
+    more neighbors) of the skeleton in one batch pass.
+
+    Returns:
+        endpoints (numpy.ndarray): (N, 2) array of (y, x) endpoint coordinates.
+        junctions (numpy.ndarray): (M, 2) array of (y, x) junction coordinates.
+    """
+    mask = skeleton > 0
+    neighbor_counts = count_skeleton_neighbors(skeleton)
+    endpoints = np.argwhere(mask & (neighbor_counts == 1))
+    junctions = np.argwhere(mask & (neighbor_counts >= 3))
+    return endpoints, junctions
 
 
 def find_endpoints(skeleton):
-    height, width = skeleton.shape
-    endpoints = []
-    for y in range(height):
-        for x in range(width):
-            if skeleton[y, x]:
-                # Count the number of neighbor skeleton pixels
-                count = 0
-                for dy in (-1, 0, 1):
-                    for dx in (-1, 0, 1):
-                        if dx == 0 and dy == 0:
-                            continue
-                        ny = y + dy
-                        nx = x + dx
-                        if 0 <= ny < height and 0 <= nx < width:
-                            if skeleton[ny, nx]:
-                                count += 1
-                if count == 1:
-                    endpoints.append((y, x))
-    return np.array(endpoints)
+    endpoints, _ = find_skeleton_nodes(skeleton)
+    return endpoints
 
 
-def bfs_traversal(skeleton, start_y, start_x):
+@njit(cache=True)
+def _bfs_traversal_kernel(skeleton, start_y, start_x):
     height, width = skeleton.shape
     visited = np.zeros((height, width), dtype=np.bool_)
     distances = np.full((height, width), -1, dtype=np.int32)
@@ -72,16 +134,132 @@ def bfs_traversal(skeleton, start_y, start_x):
     return distances, predecessors
 
 
-def reconstruct_path(predecessors, end_y, end_x):
-    path = []
+def bfs_traversal(skeleton, start_y, start_x):
+    """
+    Breadth-first search over the skeleton starting at (start_y, start_x).
+    Dispatches to the Numba-compiled kernel when available; the kernel is
+    also valid plain Python, so the contract is identical either way.
+    """
+    mask = np.ascontiguousarray(skeleton > 0)
+    return _bfs_traversal_kernel(mask, np.int32(start_y), np.int32(start_x))
+
+
+@njit(cache=True)
+def _reconstruct_path_kernel(predecessors, end_y, end_x):
+    # First walk to measure the path length, then fill a preallocated array.
+    length = 0
     y = end_y
     x = end_x
     while y != -1 and x != -1:
-        path.append((y, x))
+        length += 1
         py = predecessors[y, x, 0]
         px = predecessors[y, x, 1]
         y, x = py, px
-    path.reverse()
+
+    path = np.empty((length, 2), dtype=np.int32)
+    y = end_y
+    x = end_x
+    for i in range(length - 1, -1, -1):
+        path[i, 0] = y
+        path[i, 1] = x
+        py = predecessors[y, x, 0]
+        px = predecessors[y, x, 1]
+        y, x = py, px
+    return path
+
+
+def reconstruct_path(predecessors, end_y, end_x):
+    path = _reconstruct_path_kernel(predecessors, np.int32(end_y),
+                                    np.int32(end_x))
+    return [(int(y), int(x)) for y, x in path]
+
+
+def build_skeleton_graph(skeleton):
+    """
+    Builds a sparse graph over the skeleton pixels only, instead of
+    allocating full-frame arrays. Nodes are the skeleton pixels, stored as
+    flat coordinate arrays; the 8-connected adjacency is stored in CSR form
+    (indptr/indices), built once with vectorized NumPy operations.
+
+    Returns:
+        ys, xs (numpy.ndarray): (N,) coordinate arrays of the skeleton pixels.
+        indptr (numpy.ndarray): (N + 1,) CSR row pointers.
+        indices (numpy.ndarray): flat array of neighbor node indices.
+    """
+    mask = skeleton > 0
+    ys, xs = np.nonzero(mask)
+    ys = ys.astype(np.int32)
+    xs = xs.astype(np.int32)
+    num_nodes = ys.shape[0]
+
+    # Padded index image so neighbor lookups need no bounds checks
+    height, width = mask.shape
+    index_map = np.full((height + 2, width + 2), -1, dtype=np.int32)
+    index_map[ys + 1, xs + 1] = np.arange(num_nodes, dtype=np.int32)
+
+    sources = []
+    targets = []
+    for dy in (-1, 0, 1):
+        for dx in (-1, 0, 1):
+            if dx == 0 and dy == 0:
+                continue
+            neighbors = index_map[ys + 1 + dy, xs + 1 + dx]
+            valid = neighbors >= 0
+            sources.append(np.nonzero(valid)[0].astype(np.int32))
+            targets.append(neighbors[valid])
+
+    sources = np.concatenate(sources)
+    targets = np.concatenate(targets)
+
+    # Sort edges by source node to obtain the CSR layout
+    order = np.argsort(sources, kind='stable')
+    indices = targets[order]
+    degrees = np.bincount(sources, minlength=num_nodes)
+    indptr = np.zeros(num_nodes + 1, dtype=np.int32)
+    np.cumsum(degrees, out=indptr[1:])
+
+    return ys, xs, indptr, indices
+
+
+@njit(cache=True)
+def _bfs_sparse_kernel(indptr, indices, start):
+    num_nodes = indptr.shape[0] - 1
+    distances = np.full(num_nodes, -1, dtype=np.int32)
+    predecessors = np.full(num_nodes, -1, dtype=np.int32)
+    queue = np.empty(num_nodes, dtype=np.int32)
+    q_start = 0
+    q_end = 0
+
+    queue[q_end] = start
+    q_end += 1
+    distances[start] = 0
+
+    while q_start < q_end:
+        node = queue[q_start]
+        q_start += 1
+        for i in range(indptr[node], indptr[node + 1]):
+            neighbor = indices[i]
+            if distances[neighbor] == -1:
+                distances[neighbor] = distances[node] + 1
+                predecessors[neighbor] = node
+                queue[q_end] = neighbor
+                q_end += 1
+    return distances, predecessors
+
+
+@njit(cache=True)
+def _reconstruct_path_sparse_kernel(predecessors, end):
+    length = 0
+    node = end
+    while node != -1:
+        length += 1
+        node = predecessors[node]
+
+    path = np.empty(length, dtype=np.int32)
+    node = end
+    for i in range(length - 1, -1, -1):
+        path[i] = node
+        node = predecessors[node]
     return path
 
 
@@ -108,6 +286,11 @@ class ImageDiscretization:
         self.image = cv2.imread(self.image_path, cv2.IMREAD_UNCHANGED)
         self.have_multiple_contours = False
 
+        # Preprocessing cache: gray/binary/contours are computed once per
+        # threshold pair and shared by every consumer (see _preprocess)
+        self._preprocess_cache = None
+        self._preprocess_cache_key = None
+
         if self.image is None:
             raise FileNotFoundError(
                 f"Image file '{self.image_path}' could not be found or the path is incorrect."
@@ -118,6 +301,26 @@ class ImageDiscretization:
         self.image = self._handle_alpha_channel()
 
     def discretize_image(self):
+        # Serve unchanged (image, mode, thresholds) inputs from the
+        # persistent cache and skip the whole pipeline
+        cache_key = discretization_cache.compute_cache_key(
+            self.image_path, self.contour_mode, self.threshold_values)
+        cached = discretization_cache.load_cached_result(cache_key)
+        if cached is not None:
+            positions, have_multiple_contours = cached
+            self.have_multiple_contours = have_multiple_contours
+            return [
+                Dot(position=(int(x), int(y)), dot_id=idx)
+                for idx, (x, y) in enumerate(positions)
+            ]
+
+        dots = self._discretize_image_uncached()
+        discretization_cache.store_cached_result(
+            cache_key, np.array([dot.position for dot in dots],
+                                dtype=np.int32), self.have_multiple_contours)
+        return dots
+
+    def _discretize_image_uncached(self):
         contours, gray = self.retrieve_contours()
         has_hole = self.check_multi_contour_hole()
         if self.contour_mode == 'automatic':
@@ -151,31 +354,91 @@ class ImageDiscretization:
                 f"Invalid contour_mode '{self.contour_mode_to_use}'. Use 'automatic', 'contour' or 'path'."
             )
 
-    def check_multi_contour_hole(self):
+    def _preprocess(self):
         """
-        Checks if the image contains multiple contours and whether the largest contour has a hole.
-
-        Returns:
-            has_multiple_contours (bool): True if multiple contours are detected.
-            has_hole (bool): True if the largest contour contains a hole.
+        Computes the grayscale frame, the binary threshold and both contour
+        retrievals (external and hierarchical) in a single pass, cached per
+        threshold pair. check_multi_contour_hole, retrieve_contours and
+        retrieve_contours_all_contours are all served from this cache, so
+        one discretize_image call converts and thresholds the frame once.
+        The cache is invalidated when the threshold values change.
         """
-        # Convert the image to grayscale
-        gray = cv2.cvtColor(self.image, cv2.COLOR_BGR2GRAY)
-        gray = cv2.GaussianBlur(gray, (5, 5), 0)
+        key = tuple(self.threshold_values)
+        if self._preprocess_cache is not None \
+                and self._preprocess_cache_key == key:
+            return self._preprocess_cache
+
+        # Route the chain through UMat (OpenCL) when the one-time probe
+        # succeeds; the cv2 calls are identical either way (T-API)
+        opencl = use_opencl()
+        source = cv2.UMat(self.image) if opencl else self.image
+        stage_times = []
+        stage_start = time.perf_counter()
+
+        gray = cv2.cvtColor(source, cv2.COLOR_BGR2GRAY)
+        stage_times.append(('cvtColor', time.perf_counter() - stage_start))
+        stage_start = time.perf_counter()
 
-        # Apply thresholding
         threshold_value, max_value = self.threshold_values
         _, binary = cv2.threshold(gray, threshold_value, max_value,
                                   cv2.THRESH_BINARY_INV)
-
-        # Morphological operations
+        stage_times.append(('threshold', time.perf_counter() - stage_start))
+        stage_start = time.perf_counter()
+
+        # External contours on the plain binary, for shape retrieval
+        external_contours, _ = cv2.findContours(binary, cv2.RETR_EXTERNAL,
+                                                cv2.CHAIN_APPROX_NONE)
+        stage_times.append(('findContours', time.perf_counter() - stage_start))
+        stage_start = time.perf_counter()
+
+        # Blur + morphology cleanup, then hierarchical contours for the
+        # hole detection
+        blurred = cv2.GaussianBlur(gray, (5, 5), 0)
+        _, cleaned = cv2.threshold(blurred, threshold_value, max_value,
+                                   cv2.THRESH_BINARY_INV)
         kernel = cv2.getStructuringElement(cv2.MORPH_RECT, (3, 3))
-        binary = cv2.morphologyEx(binary, cv2.MORPH_OPEN, kernel)
-        binary = cv2.morphologyEx(binary, cv2.MORPH_CLOSE, kernel)
+        cleaned = cv2.morphologyEx(cleaned, cv2.MORPH_OPEN, kernel)
+        cleaned = cv2.morphologyEx(cleaned, cv2.MORPH_CLOSE, kernel)
+        stage_times.append(
+            ('blur+morphology', time.perf_counter() - stage_start))
+        stage_start = time.perf_counter()
+
+        ccomp_contours, hierarchy = cv2.findContours(cleaned, cv2.RETR_CCOMP,
+                                                     cv2.CHAIN_APPROX_NONE)
+        stage_times.append(
+            ('findContours (hierarchy)', time.perf_counter() - stage_start))
+
+        # Consumers work on numpy arrays, so download UMat results once
+        gray = _as_numpy(gray)
+        binary = _as_numpy(binary)
+
+        if self.debug:
+            backend = 'OpenCL' if opencl else 'CPU'
+            for stage, elapsed in stage_times:
+                print(f"Preprocess stage {stage}: "
+                      f"{elapsed * 1000:.1f} ms ({backend})")
+
+        self._preprocess_cache = {
+            'gray': gray,
+            'binary': binary,
+            'external_contours': external_contours,
+            'ccomp_contours': ccomp_contours,
+            'hierarchy': hierarchy,
+        }
+        self._preprocess_cache_key = key
+        return self._preprocess_cache
 
-        # Find contours
-        contours, hierarchy = cv2.findContours(binary, cv2.RETR_CCOMP,
-                                               cv2.CHAIN_APPROX_NONE)
+    def check_multi_contour_hole(self):
+        """
+        Checks if the image contains multiple contours and whether the largest contour has a hole.
+
+        Returns:
+            has_multiple_contours (bool): True if multiple contours are detected.
+            has_hole (bool): True if the largest contour contains a hole.
+        """
+        preprocessed = self._preprocess()
+        contours = preprocessed['ccomp_contours']
+        hierarchy = preprocessed['hierarchy']
 
         # Check if any contours are found
         if not contours:
@@ -197,13 +460,11 @@ class ImageDiscretization:
         Retrieves the largest contour found in the image and displays intermediate steps if debug is enabled.
         Also checks if the largest shape has a hole or not and prints the result.
         """
-        gray = cv2.cvtColor(self.image, cv2.COLOR_BGR2GRAY)
+        preprocessed = self._preprocess()
+        gray = preprocessed['gray']
 
-        threshold_value, max_value = self.threshold_values
-        _, binary = cv2.threshold(gray, threshold_value, max_value,
-                                  cv2.THRESH_BINARY_INV)
-
-        _, _, largest_contour = self._find_contours_discrimate_area(binary)
+        _, _, largest_contour = self._find_contours_discrimate_area(
+            preprocessed['external_contours'])
 
         if self.debug:
             # Create a blank canvas for drawing the largest contour
@@ -250,11 +511,7 @@ class ImageDiscretization:
             dots.append(Dot(position=position, dot_id=idx))
         return dots
 
-    def _find_contours_discrimate_area(self, binary):
-
-        # Use a retrieval mode that provides hierarchy information
-        contours, _ = cv2.findContours(binary, cv2.RETR_EXTERNAL,
-                                       cv2.CHAIN_APPROX_NONE)
+    def _find_contours_discrimate_area(self, contours):
 
         if not contours:
             print(
@@ -285,14 +542,11 @@ class ImageDiscretization:
         """
         Retrieves the largest contour found in the image and displays intermediate steps if debug is enabled.
         """
-        gray = cv2.cvtColor(self.image, cv2.COLOR_BGR2GRAY)
-
-        # Use the threshold values provided as arguments
-        threshold_value, max_value = self.threshold_values
-        _, binary = cv2.threshold(gray, threshold_value, max_value,
-                                  cv2.THRESH_BINARY_INV)
+        preprocessed = self._preprocess()
+        gray = preprocessed['gray']
 
-        _, filtered_contours, _ = self._find_contours_discrimate_area(binary)
+        _, filtered_contours, _ = self._find_contours_discrimate_area(
+            preprocessed['external_contours'])
         if not filtered_contours:
             print(
                 "No contours were found in the image. You can modify the binary"
@@ -313,8 +567,23 @@ class ImageDiscretization:
         # Draw the largest contour on the mask
         cv2.drawContours(mask, [contour], -1, 255, thickness=cv2.FILLED)
 
-        # Skeletonize the shape using OpenCV ximgproc thinning
-        skeleton = cv2.ximgproc.thinning(mask)
+        # Skeletonize the shape using OpenCV ximgproc thinning, on the
+        # OpenCL device when available
+        stage_start = time.perf_counter()
+        if use_opencl():
+            try:
+                skeleton = _as_numpy(cv2.ximgproc.thinning(cv2.UMat(mask)))
+                backend = 'OpenCL'
+            except cv2.error:
+                skeleton = cv2.ximgproc.thinning(mask)
+                backend = 'CPU'
+        else:
+            skeleton = cv2.ximgproc.thinning(mask)
+            backend = 'CPU'
+        if self.debug:
+            print(f"Skeleton thinning: "
+                  f"{(time.perf_counter() - stage_start) * 1000:.1f} ms "
+                  f"({backend})")
 
         if self.debug:
             debug_image = resize_for_debug(skeleton)
@@ -331,28 +600,34 @@ class ImageDiscretization:
     def _prune_skeleton_to_one_branch(self, skeleton):
         """
         Prunes the skeleton to retain only the longest branch.
-        Uses Numba-accelerated functions to improve performance.
+        Runs the double-BFS diameter search over a sparse graph of the
+        skeleton pixels, so memory stays proportional to the skeleton
+        instead of the full frame.
         """
-        # Find endpoints in the skeleton
-        endpoints = find_endpoints(skeleton)
+        # Build the sparse skeleton graph once for both BFS passes
+        ys, xs, indptr, indices = build_skeleton_graph(skeleton)
+
+        # Endpoints are the nodes with exactly one neighbor
+        degrees = indptr[1:] - indptr[:-1]
+        endpoint_nodes = np.nonzero(degrees == 1)[0]
 
-        if len(endpoints) == 0:
+        if len(endpoint_nodes) == 0:
             raise ValueError("No endpoints found in the skeleton.")
 
         # First BFS from an endpoint to find the farthest node (u)
-        start_y, start_x = endpoints[0]
-        distances1, predecessors1 = bfs_traversal(skeleton, start_y, start_x)
-        u_y, u_x = np.unravel_index(np.argmax(distances1), distances1.shape)
+        distances1, _ = _bfs_sparse_kernel(indptr, indices,
+                                           np.int32(endpoint_nodes[0]))
+        u = np.int32(np.argmax(distances1))
 
         # Second BFS from u to find the farthest node (v)
-        distances2, predecessors2 = bfs_traversal(skeleton, u_y, u_x)
-        v_y, v_x = np.unravel_index(np.argmax(distances2), distances2.shape)
+        distances2, predecessors2 = _bfs_sparse_kernel(indptr, indices, u)
+        v = np.int32(np.argmax(distances2))
 
         # Reconstruct the longest path from u to v
-        path = reconstruct_path(predecessors2, v_y, v_x)
+        path = _reconstruct_path_sparse_kernel(predecessors2, v)
 
         # Convert path to list of (x, y) tuples
-        points_list = [(x, y) for y, x in path]
+        points_list = [(int(xs[node]), int(ys[node])) for node in path]
 
         return points_list
 
@@ -0,0 +1,106 @@
+"""
+Mipmap-style pyramid of prescaled images.
+Power-of-two levels are built lazily from a source PIL image, so each
+zoom step resamples from the nearest prescaled level (and optionally
+only the visible crop) instead of re-running a full-resolution resize
+on every wheel tick.
+"""
+from PIL import Image
+
+
+class ImagePyramid:
+    """
+    Lazily built power-of-two pyramid over a PIL image.
+    """
+
+    def __init__(self, image, min_size=64,
+                 resample=Image.Resampling.LANCZOS):
+        """
+        Parameters:
+        - image: Source PIL Image (level 0 of the pyramid).
+        - min_size: Stop halving once the smaller side would drop below
+                    this size.
+        - resample: Resampling filter used to build levels and crops.
+        """
+        self.resample = resample
+        self.min_size = min_size
+        self._levels = {0: image}
+
+    @property
+    def source(self):
+        return self._levels[0]
+
+    def _get_level(self, level):
+        """
+        Returns the image halved `level` times, building (and caching)
+        any missing intermediate levels.
+        """
+        if level in self._levels:
+            return self._levels[level]
+        previous = self._get_level(level - 1)
+        width = max(1, previous.width // 2)
+        height = max(1, previous.height // 2)
+        halved = previous.resize((width, height), self.resample)
+        self._levels[level] = halved
+        return halved
+
+    def level_for_scale(self, scale):
+        """
+        Picks the nearest prescaled level that is still at least as fine
+        as the requested scale, so the final resize never upsamples a
+        coarser level.
+
+        Returns:
+        - (level, factor): Level index and its scale factor (1, 1/2, ...).
+        """
+        level = 0
+        factor = 1.0
+        smaller_side = min(self.source.width, self.source.height)
+        while (factor / 2 >= scale
+               and smaller_side * factor / 2 >= self.min_size):
+            level += 1
+            factor /= 2
+        return level, factor
+
+    def get_scaled(self, scale, resample=None):
+        """
+        Returns the whole image resized by `scale`, resampled from the
+        nearest prescaled level.
+        """
+        level, _ = self.level_for_scale(scale)
+        base = self._get_level(level)
+        target_width = max(1, int(round(self.source.width * scale)))
+        target_height = max(1, int(round(self.source.height * scale)))
+        if (base.width, base.height) == (target_width, target_height):
+            return base
+        return base.resize((target_width, target_height), resample
+                           or self.resample)
+
+    def get_scaled_crop(self, box, scale, resample=None):
+        """
+        Resamples only the given region at `scale`, for pan/zoom of the
+        visible part of a large image.
+
+        Parameters:
+        - box: (x_min, y_min, x_max, y_max) in source image coordinates.
+        - scale: Display scale factor.
+
+        Returns:
+        - The cropped region resized to (box width * scale,
+          box height * scale).
+        """
+        level, factor = self.level_for_scale(scale)
+        base = self._get_level(level)
+
+        level_box = (max(0, int(box[0] * factor)), max(0,
+                                                       int(box[1] * factor)),
+                     min(base.width, int(round(box[2] * factor))),
+                     min(base.height, int(round(box[3] * factor))))
+        crop = base.crop(level_box)
+
+        target_width = max(1, int(round((box[2] - box[0]) * scale)))
+        target_height = max(1, int(round((box[3] - box[1]) * scale)))
+        if (crop.width, crop.height) == (target_width, target_height):
+            return crop
+        return crop.resize((target_width, target_height), resample
+                           or self.resample)
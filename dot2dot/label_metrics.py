@@ -0,0 +1,88 @@
+"""
+Shared cache of label text metrics.
+PIL font shaping (font.getbbox / draw.textbbox) dominates profiles
+during label placement, so the raw metrics of each text are computed
+once per (font path, font size, text) and every anchored bounding box
+is derived from them arithmetically.
+"""
+
+# (font_path, font_size, text) -> (bbox, ascent, advance)
+_metrics_cache = {}
+
+
+def _metrics_key(font, text, font_path=None, font_size=None):
+    if font_path is None:
+        font_path = getattr(font, 'path', None) or id(font)
+    if font_size is None:
+        font_size = getattr(font, 'size', None)
+    return (font_path, font_size, text)
+
+
+def get_metrics(font, text, font_path=None, font_size=None):
+    """
+    Returns the shaped metrics of a text, computed once and cached.
+
+    Returns:
+        tuple: (bbox, ascent, advance) where bbox is the (x0, y0, x1, y1)
+        box relative to the top-left text origin, ascent the font ascent
+        in pixels and advance the horizontal advance of the text.
+    """
+    key = _metrics_key(font, text, font_path, font_size)
+    metrics = _metrics_cache.get(key)
+    if metrics is not None:
+        return metrics
+
+    try:
+        bbox = font.getbbox(text)
+    except AttributeError:
+        width, height = font.getsize(text)
+        bbox = (0, 0, width, height)
+
+    try:
+        ascent, _ = font.getmetrics()
+    except AttributeError:
+        ascent = bbox[3]
+
+    try:
+        advance = font.getlength(text)
+    except AttributeError:
+        advance = bbox[2]
+
+    metrics = (bbox, ascent, advance)
+    _metrics_cache[key] = metrics
+    return metrics
+
+
+def get_text_size(font, text, font_path=None, font_size=None):
+    """
+    Returns the (width, height) of a text from the cached metrics.
+    """
+    bbox, _, _ = get_metrics(font, text, font_path, font_size)
+    return bbox[2] - bbox[0], bbox[3] - bbox[1]
+
+
+def anchored_bbox(position, font, text, anchor, font_path=None,
+                  font_size=None):
+    """
+    Derives the bounding box of a text placed at the given position with
+    the given PIL anchor (e.g. 'ls', 'rs', 'ms'), equivalent to
+    draw.textbbox but without re-shaping the text.
+
+    Returns:
+        tuple: (x_min, y_min, x_max, y_max).
+    """
+    bbox, ascent, advance = get_metrics(font, text, font_path, font_size)
+    x, y = position
+
+    horizontal = anchor[0] if anchor else 'l'
+    vertical = anchor[1] if len(anchor) > 1 else 'a'
+
+    if horizontal == 'r':
+        x -= advance
+    elif horizontal == 'm':
+        x -= advance / 2
+
+    if vertical == 's':
+        y -= ascent
+
+    return (x + bbox[0], y + bbox[1], x + bbox[2], y + bbox[3])
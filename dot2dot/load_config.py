@@ -5,7 +5,7 @@ default or a custom configuration from a JSON file.
 import json
 import os
 from jsonschema import validate, ValidationError
-from dot2dot.utils import get_base_directory, parse_rgba
+from dot2dot.basic_utils import get_base_directory, parse_rgba
 from dot2dot.default_scheme_config import DEFAULT_CONFIG_CONTENT, CONFIG_SCHEMA
 
 
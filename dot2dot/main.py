@@ -1,16 +1,18 @@
 """
 Entry point of the full dot to dot application
+
+Only the standard library and the configuration loader are imported at
+module level: cv2, PIL, numpy and the whole Tkinter GUI stack are
+deferred into the branch that actually needs them, so `--help`, batch
+runs and headless invocations do not pay the multi-second GUI import
+cost (worse in the frozen executable built by build_script.py).
 """
 import argparse
 import traceback
 import sys
 import os
-import cv2
 
-from dot2dot.utils import str2bool, generate_output_path, save_image, resize_for_debug, display_with_opencv
-from dot2dot.gui.main_gui import DotToDotGUI
-from dot2dot.dots_config import DotsConfig
-from dot2dot.processing import process_single_image
+from dot2dot.basic_utils import str2bool
 from dot2dot.load_config import LoadConfig
 
 
@@ -120,10 +122,60 @@ def main():
                             type=str2bool,
                             default=True,
                             help='Launch the graphical user interface.')
+        parser.add_argument(
+            '-b',
+            '--batch',
+            type=str,
+            default=None,
+            help='Process all images of the given folder without the GUI.')
+        parser.add_argument(
+            '-j',
+            '--jobs',
+            type=int,
+            default=None,
+            help=
+            'Number of worker processes in batch mode (default: CPU count).')
+        parser.add_argument(
+            '-mc',
+            '--multiContour',
+            type=str2bool,
+            nargs='?',
+            const=True,
+            default=False,
+            help=
+            'Process every shape of the image in parallel with per-shape numbering '
+            'instead of only the largest one.')
+        parser.add_argument(
+            '-ltb',
+            '--labelTimeBudget',
+            type=float,
+            default=config["labelTimeBudget"] or 0.0,
+            help=
+            'Seconds allowed for the extra label placement pass that resolves '
+            'overlapping labels (default: 0, disabled).')
+        parser.add_argument(
+            '-p',
+            '--profile',
+            type=str2bool,
+            nargs='?',
+            const=True,
+            default=False,
+            help=
+            'Print wall time, peak memory and input sizes for each processing stage.'
+        )
         args = parser.parse_args()
 
-        if args.gui:
+        if args.batch:
+            from dot2dot.batch_processing import run_batch
+            failures = run_batch(config,
+                                 args.batch,
+                                 args.output,
+                                 args.jobs,
+                                 label_time_budget=args.labelTimeBudget)
+            sys.exit(1 if failures else 0)
+        elif args.gui:
             try:
+                from dot2dot.gui.main_gui import DotToDotGUI
                 app = DotToDotGUI(config)
                 app.run()
             except ImportError as _:
@@ -137,7 +189,20 @@ def main():
                 sys.exit(1)
         else:
             try:
+                import cv2
+
+                from dot2dot import profiling
+                from dot2dot.dots_config import DotsConfig
+                from dot2dot.multi_contour import process_all_contours
+                from dot2dot.processing import process_single_image
+                from dot2dot.utils import (generate_output_path, save_image,
+                                           resize_for_debug,
+                                           display_with_opencv)
+
                 dots_config = DotsConfig.arg_parse_to_dots_config(args)
+                profiler = profiling.StageProfiler() if args.profile else None
+                process_image = (process_all_contours
+                                 if args.multiContour else process_single_image)
                 # [Existing command-line processing code]
                 print("Processing picture(s) to dot to dot...")
 
@@ -163,29 +228,33 @@ def main():
                             input_path,
                             os.path.join(output_dir, image_file)
                             if args.output else None)
-                        output_image_with_dots, _, _, _, _ = process_single_image(
-                            dots_config)
+                        output_image_with_dots, _, _, _, _ = process_image(
+                            dots_config, profiler=profiler)
                         if output_path_for_file:
                             print(
                                 f"Saving the output image to {output_path_for_file}..."
                             )
                             # Save the output images with the specified DPI
-                            save_image(output_image_with_dots,
-                                       output_path_for_file, dots_config.dpi)
+                            with profiling.stage(profiler, "save"):
+                                save_image(output_image_with_dots,
+                                           output_path_for_file,
+                                           dots_config.dpi)
 
                 # Otherwise, process a single image
                 elif os.path.isfile(dots_config.input_path):
                     output_path = generate_output_path(dots_config.input_path,
                                                        args.output)
-                    output_image_with_dots, _, _, _, _ = process_single_image(
-                        dots_config)
+                    output_image_with_dots, _, _, _, _ = process_image(
+                        dots_config, profiler=profiler)
                     if dots_config.output_path:
                         print(
                             f"Saving the output image to {dots_config.output_path}..."
                         )
                         # Save the output images with the specified DPI
-                        save_image(output_image_with_dots,
-                                   dots_config.output_path, dots_config.dpi)
+                        with profiling.stage(profiler, "save"):
+                            save_image(output_image_with_dots,
+                                       dots_config.output_path,
+                                       dots_config.dpi)
                         # Display output if --displayOutput is set or --debug is
                         # enabled
                         if args.debug or args.displayOutput:
@@ -201,6 +270,9 @@ def main():
                     )
 
                 print("Processing complete.")
+                if profiler is not None:
+                    profiler.print_report()
+                    profiler.close()
             except Exception as e:
                 print("Error occurred in command-line mode:", str(e))
                 traceback.print_exc()
@@ -0,0 +1,186 @@
+"""
+Parallel multi-contour processing.
+
+process_single_image only keeps the largest shape of the image, so a
+sheet with several shapes needs one run per shape. process_all_contours
+takes every filtered contour from retrieve_contours_all_contours, runs
+the per-shape pipeline (contour walk or skeletonization, then
+simplification and distance filtering) in a pool of worker processes,
+and merges the results into one dot set — one parallel run instead of N
+sequential ones. Merged dots keep globally unique sequential ids (the
+grids and the edit window rely on dot_id == index + 1); only the
+displayed label numbers restart at 1 for each shape.
+"""
+
+import multiprocessing
+import time
+
+import cv2
+
+from dot2dot import profiling
+from dot2dot.dot import Dot
+from dot2dot.dots_selection import DotsSelection
+from dot2dot.image_creation import ImageCreation
+from dot2dot.image_discretization import ImageDiscretization
+
+# Per-worker state, built once in _init_worker and reused for every
+# contour handled by that worker (the image and its preprocessing are
+# loaded a single time per worker).
+_worker_state = None
+
+
+def _init_worker(image_path, contour_mode, threshold_values, epsilon,
+                 distance_min, distance_max):
+    """
+    Initializes a worker process with the shared image, grayscale frame
+    and selection parameters. `contour_mode` is already resolved to
+    'contour' or 'path' by the parent.
+    """
+    global _worker_state
+    discretization = ImageDiscretization(image_path, contour_mode,
+                                         list(threshold_values), False)
+    _worker_state = {
+        "discretization": discretization,
+        "gray": discretization._preprocess()['gray'],
+        "mode": contour_mode,
+        "epsilon": epsilon,
+        "distance_min": distance_min,
+        "distance_max": distance_max,
+    }
+
+
+def _process_one_contour(task):
+    """
+    Runs the per-shape pipeline on one contour in a worker.
+
+    Returns:
+        tuple: (shape_index, list of (x, y) positions). Only plain
+               tuples cross the process boundary; Dot objects carry PIL
+               fonts once labelled and do not pickle.
+    """
+    shape_index, contour = task
+    state = _worker_state
+    discretization = state["discretization"]
+
+    if state["mode"] == 'path':
+        skeleton_path = discretization._retrieve_skeleton_path(
+            contour, state["gray"])
+        dots = discretization._skeleton_to_dots(skeleton_path)
+    else:
+        dots = discretization._contours_to_dots(contour)
+
+    # Shapes too small to simplify keep their raw points
+    if len(dots) < 3:
+        return shape_index, [dot.position for dot in dots]
+
+    dots_selection = DotsSelection(epsilon_factor=state["epsilon"],
+                                   max_distance=state["distance_max"],
+                                   min_distance=state["distance_min"],
+                                   dots=dots,
+                                   debug=False)
+    selected_dots = dots_selection.contour_to_linear_paths()
+    return shape_index, [dot.position for dot in selected_dots]
+
+
+def process_all_contours(dots_config,
+                         debug=False,
+                         cancel_token=None,
+                         profiler=None,
+                         jobs=None):
+    """
+    Processes every shape of the image in parallel and draws the merged
+    dot set. Mirrors the return value of process_single_image:
+    (output image, combined image, elapsed seconds, dots, False), or
+    None when cancelled or when no contour is found.
+
+    Parameters:
+    - jobs: Number of worker processes (default: one per shape, capped
+      at the CPU count).
+    """
+    start_time = time.time()
+
+    def is_cancelled():
+        return cancel_token is not None and cancel_token.cancelled
+
+    print(f"Processing all shapes of {dots_config.input_path} "
+          f"using '{dots_config.shape_detection}' method...")
+
+    original_image = cv2.imread(dots_config.input_path)
+    if original_image is None:
+        print(f"Couldn't process at address {dots_config.input_path}, "
+              "which isn't a readable image.")
+        return
+    image_height, image_width = original_image.shape[:2]
+
+    discretization = ImageDiscretization(dots_config.input_path,
+                                         dots_config.shape_detection,
+                                         dots_config.threshold_binary, debug)
+    with profiling.stage(profiler, "contours"):
+        filtered_contours, _ = discretization.retrieve_contours_all_contours()
+    if not filtered_contours:
+        return
+
+    # Resolve 'automatic' once here so every worker uses the same method
+    contour_mode = dots_config.shape_detection.lower()
+    if contour_mode == 'automatic':
+        contour_mode = 'contour' if discretization.check_multi_contour_hole(
+        ) else 'path'
+
+    if is_cancelled():
+        print("Multi-contour processing canceled after contour retrieval.")
+        return
+
+    tasks = list(enumerate(filtered_contours))
+    worker_count = jobs if jobs else min(len(tasks),
+                                         multiprocessing.cpu_count())
+    worker_count = max(1, worker_count)
+    print(f"Processing {len(tasks)} shapes on {worker_count} workers...")
+
+    with profiling.stage(profiler, "shapes", num_shapes=len(tasks)):
+        with multiprocessing.Pool(
+                processes=worker_count,
+                initializer=_init_worker,
+                initargs=(dots_config.input_path, contour_mode,
+                          list(dots_config.threshold_binary),
+                          dots_config.epsilon, dots_config.distance_min,
+                          dots_config.distance_max)) as pool:
+            shape_results = pool.map(_process_one_contour, tasks)
+
+    if is_cancelled():
+        print("Multi-contour processing canceled after shape processing.")
+        return
+
+    # Merge in shape order with globally unique sequential ids;
+    # shape_starts lets ImageCreation restart the displayed numbers at 1
+    # for each shape and break the connecting lines between shapes
+    merged_dots = []
+    shape_starts = []
+    for _, positions in sorted(shape_results):
+        shape_starts.append(len(merged_dots))
+        for position in positions:
+            merged_dots.append(
+                Dot(position=(int(position[0]), int(position[1])),
+                    dot_id=len(merged_dots) + 1))
+
+    image_creation = ImageCreation(
+        image_size=(image_height, image_width),
+        dots=merged_dots,
+        dot_control=dots_config.dot_control,
+        debug=debug,
+        placement_time_budget=dots_config.label_time_budget,
+        shape_starts=shape_starts)
+    with profiling.stage(profiler, "draw", num_dots=len(merged_dots)):
+        output_image_with_dots, updated_dots, combined_image_np = \
+            image_creation.draw_points_on_image(dots_config.input_path)
+
+    if is_cancelled():
+        print("Multi-contour processing canceled after drawing.")
+        return
+
+    elapsed_time = time.time() - start_time
+    print(f"Elapsed time for multi-contour processing: "
+          f"{elapsed_time:.2f} seconds")
+
+    # The shapes were all handled, so no multiple-contour warning
+    return (output_image_with_dots, combined_image_np, elapsed_time,
+            updated_dots, False)
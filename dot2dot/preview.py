@@ -0,0 +1,78 @@
+"""
+Bounded-size preview inputs for interactive parameter tuning.
+
+The shape visualization and dot disposition windows recompute the
+discretization while the user drags sliders, which is unusable on
+8K-class scans. get_preview_input downsamples the working image once to
+a bounded longest side, caches it under the config directory keyed by
+the source file's path and modification time, and returns the scale
+factor mapping preview coordinates back to full resolution, so the
+interactive windows work on a thumbnail-sized image while displaying
+(and applying) values in full-resolution pixel space. Full resolution
+only runs when the user presses Process in the main window.
+"""
+
+import hashlib
+import os
+
+import cv2
+
+from dot2dot.basic_utils import get_base_directory
+
+# Longest side of the image the interactive windows recompute on
+PREVIEW_MAX_SIDE = 1024
+
+
+def get_preview_directory():
+    """
+    Returns the preview cache directory under the config directory,
+    creating it if needed.
+    """
+    base_directory = get_base_directory()
+    preview_directory = os.path.join(base_directory, 'assets', 'config',
+                                     'preview_cache')
+    if not os.path.exists(preview_directory):
+        os.makedirs(preview_directory)
+    return preview_directory
+
+
+def get_preview_input(input_path, max_side=PREVIEW_MAX_SIDE):
+    """
+    Returns (image_path, scale) for interactive recomputes.
+
+    Images whose longest side already fits in `max_side` are returned
+    untouched with scale 1.0. Larger images are downsampled once to
+    `max_side` on their longest side, written to the preview cache and
+    reused until the source file changes. `scale` converts preview
+    coordinates back to full-resolution coordinates (original = preview
+    * scale).
+    """
+    try:
+        image = cv2.imread(input_path)
+        if image is None:
+            return input_path, 1.0
+        height, width = image.shape[:2]
+        longest = max(width, height)
+        if longest <= max_side:
+            return input_path, 1.0
+
+        try:
+            mtime = os.path.getmtime(input_path)
+        except OSError:
+            mtime = 0.0
+        key = hashlib.sha1(
+            f"{os.path.abspath(input_path)}|{mtime}|{max_side}".encode(
+                "utf-8")).hexdigest()
+        preview_path = os.path.join(get_preview_directory(), f"{key}.png")
+
+        factor = max_side / float(longest)
+        new_width = max(1, int(round(width * factor)))
+        new_height = max(1, int(round(height * factor)))
+        if not os.path.isfile(preview_path):
+            resized = cv2.resize(image, (new_width, new_height),
+                                 interpolation=cv2.INTER_AREA)
+            cv2.imwrite(preview_path, resized)
+        return preview_path, float(width) / float(new_width)
+    except Exception as error:
+        print(f"Could not build preview image for {input_path}: {error}")
+        return input_path, 1.0
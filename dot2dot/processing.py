@@ -4,14 +4,32 @@ Function to process a full image to a dot to dot image.
 import os
 import time
 import cv2
+from dot2dot import profiling
 from dot2dot.image_discretization import ImageDiscretization
 from dot2dot.dots_selection import DotsSelection
 from dot2dot.image_creation import ImageCreation
 
 
-def process_single_image(dots_config, debug=False):
+def process_single_image(dots_config,
+                         debug=False,
+                         cancel_token=None,
+                         profiler=None):
+    """
+    Runs the full discretization/selection/drawing chain on one image.
+    When `cancel_token` is given, the chain is checked between stages and
+    returns None early once the token is cancelled, so superseded GUI
+    recomputes stop instead of running to completion.
+    When `profiler` is given (a profiling.StageProfiler), each stage is
+    timed with its input sizes so slow customer images can be diagnosed.
+    """
     start_time = time.time()
 
+    def is_cancelled():
+        return cancel_token is not None and cancel_token.cancelled
+
+    def stage(name, **sizes):
+        return profiling.stage(profiler, name, **sizes)
+
     print(f"Loading the corrected image from {dots_config.input_path}...")
 
     if not os.path.isfile(dots_config.input_path):
@@ -20,7 +38,8 @@ def process_single_image(dots_config, debug=False):
         )
         return
     # Load the corrected image for processing
-    original_image = cv2.imread(dots_config.input_path)
+    with stage("load_image"):
+        original_image = cv2.imread(dots_config.input_path)
 
     image_height, image_width = original_image.shape[:2]
 
@@ -28,12 +47,18 @@ def process_single_image(dots_config, debug=False):
         f"Processing image {dots_config.input_path} using '{dots_config.shape_detection}' method..."
     )
 
-    # Step 1: Image discretization
+    # Step 1: Image discretization (thresholding plus contour or
+    # skeleton extraction)
     image_discretization = ImageDiscretization(dots_config.input_path,
                                                dots_config.shape_detection,
                                                dots_config.threshold_binary,
                                                debug)
-    dots = image_discretization.discretize_image()
+    with stage("discretize", pixels=image_width * image_height):
+        dots = image_discretization.discretize_image()
+
+    if is_cancelled():
+        print("Processing canceled after discretization.")
+        return
 
     # Step 2: Dot selection and filtering
     dots_selection = DotsSelection(epsilon_factor=dots_config.epsilon,
@@ -41,20 +66,34 @@ def process_single_image(dots_config, debug=False):
                                    min_distance=dots_config.distance_min,
                                    dots=dots,
                                    debug=debug)
-    # Returns a refined list of Dot objects
-    selected_dots = dots_selection.contour_to_linear_paths()
+    # Returns a refined list of Dot objects (simplification, midpoint
+    # insertion and close-point pruning)
+    with stage("dot_selection", num_points=len(dots)):
+        selected_dots = dots_selection.contour_to_linear_paths()
+
+    if is_cancelled():
+        print("Processing canceled after dot selection.")
+        return
 
     print("Drawing points and labels on the image...")
 
     # Create an instance of ImageCreation with required parameters
-    image_creation = ImageCreation(image_size=(image_height, image_width),
-                                   dots=selected_dots,
-                                   dot_control=dots_config.dot_control,
-                                   debug=debug)
+    image_creation = ImageCreation(
+        image_size=(image_height, image_width),
+        dots=selected_dots,
+        dot_control=dots_config.dot_control,
+        debug=debug,
+        placement_time_budget=dots_config.label_time_budget)
 
     # Draw the points on the image with a transparent background
-    output_image_with_dots, updated_dots, combined_image_np = image_creation.draw_points_on_image(
-        dots_config.input_path)
+    # (includes label placement)
+    with stage("draw", num_dots=len(selected_dots)):
+        output_image_with_dots, updated_dots, combined_image_np = image_creation.draw_points_on_image(
+            dots_config.input_path)
+
+    if is_cancelled():
+        print("Processing canceled after drawing.")
+        return
 
     elapsed_time = time.time() - start_time
 
@@ -0,0 +1,144 @@
+"""
+Per-stage instrumentation for the processing pipeline.
+
+A StageProfiler is passed down to process_single_image and records, for
+every stage it wraps, the wall time, the peak traced memory (when
+memory tracking is enabled) and the input sizes the caller declares.
+Listeners can subscribe to finished stages, which is how the GUI shows
+live timings while a run is in progress; the CLI prints the final
+report as a table with --profile.
+"""
+
+import time
+import tracemalloc
+from contextlib import nullcontext
+
+
+def stage(profiler, name, **sizes):
+    """
+    Returns `profiler.stage(name, **sizes)`, or a no-op context manager
+    when `profiler` is None, so call sites can instrument stages without
+    branching on whether profiling is active.
+    """
+    if profiler is None:
+        return nullcontext()
+    return profiler.stage(name, **sizes)
+
+
+class StageProfiler:
+    """
+    Records wall time, peak memory and input sizes per pipeline stage.
+
+    Usage:
+        profiler = StageProfiler()
+        with profiler.stage("discretize", pixels=width * height):
+            ...
+        profiler.print_report()
+    """
+
+    def __init__(self, track_memory=True):
+        """
+        Parameters:
+        - track_memory: Enables tracemalloc-based peak memory tracking.
+          Tracing is process-wide and slows allocation, so the GUI
+          disables it for interactive runs.
+        """
+        self.records = []
+        self.track_memory = track_memory
+        self._listeners = []
+        self._started = time.perf_counter()
+        self._owns_tracemalloc = False
+        if track_memory and not tracemalloc.is_tracing():
+            tracemalloc.start()
+            self._owns_tracemalloc = True
+
+    def add_listener(self, callback):
+        """
+        Registers a callback invoked with the record dict of every
+        finished stage: {"name", "seconds", "peak_memory_bytes", sizes}.
+        """
+        self._listeners.append(callback)
+
+    def stage(self, name, **sizes):
+        """
+        Returns a context manager timing one stage. Keyword arguments
+        are recorded verbatim as the stage input sizes (e.g.
+        pixels=..., num_dots=...).
+        """
+        return _StageContext(self, name, sizes)
+
+    def _record(self, record):
+        self.records.append(record)
+        for listener in self._listeners:
+            try:
+                listener(record)
+            except Exception as error:
+                print(f"Profiler listener failed: {error}")
+
+    def report(self):
+        """
+        Returns the structured report: total elapsed seconds and the
+        per-stage record list, suitable for JSON serialization.
+        """
+        return {
+            "total_seconds": time.perf_counter() - self._started,
+            "memory_tracked": self.track_memory,
+            "stages": list(self.records),
+        }
+
+    def print_report(self):
+        """
+        Prints the report as an aligned table.
+        """
+        report = self.report()
+        print("Stage timings:")
+        for record in report["stages"]:
+            line = f"  {record['name']:<24}{record['seconds'] * 1000.0:>10.1f} ms"
+            peak = record.get("peak_memory_bytes")
+            if peak is not None:
+                line += f"{peak / (1024.0 * 1024.0):>10.1f} MB peak"
+            sizes = record.get("sizes")
+            if sizes:
+                line += "  " + ", ".join(
+                    f"{key}={value}" for key, value in sizes.items())
+            print(line)
+        print(f"  {'total':<24}{report['total_seconds'] * 1000.0:>10.1f} ms")
+
+    def close(self):
+        """
+        Stops memory tracing if this profiler started it.
+        """
+        if self._owns_tracemalloc and tracemalloc.is_tracing():
+            tracemalloc.stop()
+            self._owns_tracemalloc = False
+
+
+class _StageContext:
+    """
+    Context manager produced by StageProfiler.stage.
+    """
+
+    def __init__(self, profiler, name, sizes):
+        self.profiler = profiler
+        self.name = name
+        self.sizes = sizes
+        self._start = None
+
+    def __enter__(self):
+        if self.profiler.track_memory and tracemalloc.is_tracing():
+            tracemalloc.reset_peak()
+        self._start = time.perf_counter()
+        return self
+
+    def __exit__(self, exc_type, exc_value, exc_traceback):
+        record = {
+            "name": self.name,
+            "seconds": time.perf_counter() - self._start,
+        }
+        if self.profiler.track_memory and tracemalloc.is_tracing():
+            record["peak_memory_bytes"] = tracemalloc.get_traced_memory()[1]
+        if self.sizes:
+            record["sizes"] = dict(self.sizes)
+        self.profiler._record(record)
+        # Never swallow stage exceptions
+        return False
@@ -0,0 +1,243 @@
+"""
+Streaming export writers for dot sets.
+
+Every writer here emits its output incrementally from the dot list --
+one circle, row or coordinate pair at a time -- instead of building the
+whole document in memory first, so exporting 100k+ dots stays flat in
+memory. The SVG and PDF writers produce vector output directly from
+the dot positions and label metrics, skipping full-resolution
+rasterization entirely.
+"""
+
+import os
+
+# Control points of a cubic Bezier quarter arc approximating a circle
+_BEZIER_K = 0.5522847498
+
+
+def _format_number(value, precision=6):
+    """
+    Formats a coordinate compactly: integral values without a decimal
+    point, others rounded to `precision` digits.
+    """
+    value = float(value)
+    if value.is_integer():
+        return str(int(value))
+    return repr(round(value, precision))
+
+
+def write_geojson_polygon(path, coordinates, precision=6):
+    """
+    Streams a GeoJSON Polygon to `path` from an iterable of (x, y)
+    pairs, closing the ring automatically.
+
+    Returns:
+        int: Number of coordinate pairs written (excluding the closing
+             pair).
+    """
+    count = 0
+    first_pair = None
+    last_pair = None
+    with open(path, "w", encoding="utf-8") as stream:
+        stream.write('{"type": "Polygon", "coordinates": [[')
+        for x, y in coordinates:
+            pair = (f"[{_format_number(x, precision)}, "
+                    f"{_format_number(y, precision)}]")
+            if count:
+                stream.write(", ")
+            else:
+                first_pair = pair
+            stream.write(pair)
+            last_pair = pair
+            count += 1
+        if first_pair is not None and last_pair != first_pair:
+            stream.write(", " + first_pair)
+        stream.write("]]}\n")
+    return count
+
+
+def write_csv(path, dots, precision=6):
+    """
+    Streams one row per dot: dot_id, x, y, radius.
+    """
+    with open(path, "w", encoding="utf-8", newline="") as stream:
+        stream.write("dot_id,x,y,radius\n")
+        for dot in dots:
+            x, y = dot.position
+            stream.write(f"{int(dot.dot_id)},"
+                         f"{_format_number(x, precision)},"
+                         f"{_format_number(y, precision)},"
+                         f"{_format_number(dot.radius, precision)}\n")
+
+
+def _hex_color(color):
+    return f"#{int(color[0]):02X}{int(color[1]):02X}{int(color[2]):02X}"
+
+
+def _opacity(color):
+    if len(color) > 3:
+        return int(color[3]) / 255.0
+    return 1.0
+
+
+# PIL horizontal anchors mapped onto SVG text-anchor values
+_SVG_TEXT_ANCHORS = {"l": "start", "m": "middle", "r": "end"}
+
+
+def _xml_escape(text):
+    return (text.replace("&", "&amp;").replace("<", "&lt;").replace(
+        ">", "&gt;"))
+
+
+def write_svg(path, dots, image_size, include_labels=True, precision=2):
+    """
+    Streams an SVG document with one circle per dot and, optionally,
+    one text element per label, in image pixel coordinates.
+
+    Parameters:
+    - image_size: (width, height) of the source image, used for the
+      viewBox.
+    """
+    width, height = image_size
+    with open(path, "w", encoding="utf-8") as stream:
+        stream.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+        stream.write(f'<svg xmlns="http://www.w3.org/2000/svg" '
+                     f'width="{int(width)}" height="{int(height)}" '
+                     f'viewBox="0 0 {int(width)} {int(height)}">\n')
+        for dot in dots:
+            x, y = dot.position
+            stream.write(f'  <circle cx="{_format_number(x, precision)}" '
+                         f'cy="{_format_number(y, precision)}" '
+                         f'r="{_format_number(dot.radius, precision)}" '
+                         f'fill="{_hex_color(dot.color)}" '
+                         f'fill-opacity="{_opacity(dot.color):.3f}"/>\n')
+        if include_labels:
+            for dot in dots:
+                label = dot.label
+                if label is None:
+                    continue
+                x, y = label.position
+                anchor = _SVG_TEXT_ANCHORS.get(
+                    str(label.anchor)[:1], "start")
+                font_family = os.path.splitext(
+                    os.path.basename(label.font_path))[0]
+                stream.write(
+                    f'  <text x="{_format_number(x, precision)}" '
+                    f'y="{_format_number(y, precision)}" '
+                    f'font-family="{_xml_escape(font_family)}" '
+                    f'font-size="{int(label.font_size)}" '
+                    f'text-anchor="{anchor}" '
+                    f'fill="{_hex_color(label.color)}">'
+                    f'{_xml_escape(str(label.text))}</text>\n')
+        stream.write("</svg>\n")
+
+
+def _pdf_escape(text):
+    return (text.replace("\\", "\\\\").replace("(", "\\(").replace(
+        ")", "\\)"))
+
+
+def _pdf_circle(stream, x, y, radius, color):
+    """
+    Appends a filled circle (four Bezier quarter arcs) to the content
+    stream, in PDF coordinates (y up).
+    """
+    k = _BEZIER_K * radius
+    r, g, b = (int(color[0]) / 255.0, int(color[1]) / 255.0,
+               int(color[2]) / 255.0)
+    stream.write(f"{r:.3f} {g:.3f} {b:.3f} rg\n".encode("ascii"))
+    stream.write(f"{x + radius:.2f} {y:.2f} m\n".encode("ascii"))
+    stream.write((f"{x + radius:.2f} {y + k:.2f} "
+                  f"{x + k:.2f} {y + radius:.2f} "
+                  f"{x:.2f} {y + radius:.2f} c\n").encode("ascii"))
+    stream.write((f"{x - k:.2f} {y + radius:.2f} "
+                  f"{x - radius:.2f} {y + k:.2f} "
+                  f"{x - radius:.2f} {y:.2f} c\n").encode("ascii"))
+    stream.write((f"{x - radius:.2f} {y - k:.2f} "
+                  f"{x - k:.2f} {y - radius:.2f} "
+                  f"{x:.2f} {y - radius:.2f} c\n").encode("ascii"))
+    stream.write((f"{x + k:.2f} {y - radius:.2f} "
+                  f"{x + radius:.2f} {y - k:.2f} "
+                  f"{x + radius:.2f} {y:.2f} c\n").encode("ascii"))
+    stream.write(b"f\n")
+
+
+def write_pdf(path, dots, image_size, include_labels=True):
+    """
+    Streams a single-page PDF with one filled circle per dot and the
+    labels as Helvetica text at their glyph positions. The page uses
+    one PDF unit per image pixel; the vertical axis is flipped since
+    PDF places the origin at the bottom-left corner.
+
+    The content stream length is an indirect reference written after
+    the stream, so the whole document is produced in one pass.
+    """
+    width, height = image_size
+    offsets = {}
+    with open(path, "wb") as stream:
+        stream.write(b"%PDF-1.4\n")
+
+        def begin_obj(number):
+            offsets[number] = stream.tell()
+            stream.write(f"{number} 0 obj\n".encode("ascii"))
+
+        begin_obj(1)
+        stream.write(b"<< /Type /Catalog /Pages 2 0 R >>\nendobj\n")
+        begin_obj(2)
+        stream.write(b"<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n")
+        begin_obj(3)
+        stream.write((f"<< /Type /Page /Parent 2 0 R "
+                      f"/MediaBox [0 0 {int(width)} {int(height)}] "
+                      f"/Contents 4 0 R "
+                      f"/Resources << /Font << /F1 6 0 R >> >> "
+                      f">>\nendobj\n").encode("ascii"))
+        begin_obj(4)
+        stream.write(b"<< /Length 5 0 R >>\nstream\n")
+        content_start = stream.tell()
+        for dot in dots:
+            x, y = dot.position
+            _pdf_circle(stream, float(x),
+                        float(height) - float(y), float(dot.radius),
+                        dot.color)
+        if include_labels:
+            for dot in dots:
+                label = dot.label
+                if label is None:
+                    continue
+                x, y = label.position
+                x = float(x)
+                y = float(height) - float(y)
+                text = str(label.text)
+                # Approximate Helvetica advance to honor the middle
+                # and right anchors
+                advance = 0.5 * label.font_size * len(text)
+                anchor = str(label.anchor)[:1]
+                if anchor == "m":
+                    x -= advance / 2.0
+                elif anchor == "r":
+                    x -= advance
+                r, g, b = (int(label.color[0]) / 255.0,
+                           int(label.color[1]) / 255.0,
+                           int(label.color[2]) / 255.0)
+                stream.write(
+                    (f"BT /F1 {int(label.font_size)} Tf "
+                     f"{r:.3f} {g:.3f} {b:.3f} rg "
+                     f"{x:.2f} {y:.2f} Td "
+                     f"({_pdf_escape(text)}) Tj ET\n").encode("latin-1",
+                                                              "replace"))
+        content_length = stream.tell() - content_start
+        stream.write(b"endstream\nendobj\n")
+        begin_obj(5)
+        stream.write(f"{content_length}\nendobj\n".encode("ascii"))
+        begin_obj(6)
+        stream.write(b"<< /Type /Font /Subtype /Type1 "
+                     b"/BaseFont /Helvetica >>\nendobj\n")
+
+        xref_start = stream.tell()
+        stream.write(b"xref\n0 7\n")
+        stream.write(b"0000000000 65535 f \n")
+        for number in range(1, 7):
+            stream.write(f"{offsets[number]:010d} 00000 n \n".encode("ascii"))
+        stream.write(b"trailer\n<< /Size 7 /Root 1 0 R >>\n")
+        stream.write(f"startxref\n{xref_start}\n".encode("ascii"))
+        stream.write(b"%%EOF\n")
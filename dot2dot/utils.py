@@ -7,45 +7,12 @@ from typing import List, Tuple
 import numpy as np
 from PIL import Image, ImageTk
 import cv2
-
-
-def str_color_to_tuple(color_str):
-    split_str = color_str.split(',')
-    if split_str == ['']:
-        return tuple()
-    color_list = []
-    for s in split_str:
-        s_int = str_to_int_safe(s)
-        if s_int is None:
-            return tuple()
-        color_list.append(s_int)
-    return tuple(color_list)
-
-
-def str_to_int_safe(str_to_convert):
-    if str_to_convert != '':
-        return int(str_to_convert)
-    else:
-        return None
-
-
-def get_base_directory():
-    """
-    Determines the base directory for the application, depending on whether it's run
-    as a standalone executable via PyInstaller or cx_Freeze, or as a normal Python script.
-
-    - PyInstaller sets sys._MEIPASS when frozen.
-    - cx_Freeze sets sys.frozen = True but does not provide sys._MEIPASS.
-      Instead, the executable directory (os.path.dirname(sys.executable)) can be used.
-
-    If not frozen at all, we return the parent directory of the current file.
-    """
-    if getattr(sys, 'frozen', False):
-        return os.path.dirname(sys.executable)
-    else:
-        # Running normally as a script
-        current_directory = os.path.abspath(os.path.dirname(__file__))
-        return os.path.abspath(os.path.join(current_directory, os.pardir))
+# Dependency-free helpers live in basic_utils so the startup path can
+# use them without importing cv2/PIL/numpy; re-exported here for the
+# existing call sites
+from dot2dot.basic_utils import (str_color_to_tuple, str_to_int_safe,
+                                 get_base_directory, rgba_to_hex, parse_rgba,
+                                 str2bool)
 
 
 def distance_to_segment(px, py, x1, y1, x2, y2):
@@ -89,51 +56,6 @@ def distance_to_segment(px, py, x1, y1, x2, y2):
         return np.linalg.norm(point - projection_point)
 
 
-def rgba_to_hex(rgba):
-    """
-    Converts an RGBA string or tuple to a hexadecimal color code.
-    Ignores the alpha channel.
-
-    Parameters:
-    - rgba: String representing RGBA values separated by commas or a tuple of (R, G, B, A).
-
-    Returns:
-    - Hexadecimal color code string.
-    """
-    try:
-        if isinstance(rgba, str):
-            parts = rgba.split(',')
-            if len(parts) != 4:
-                raise ValueError(
-                    "RGBA string must have exactly four components.")
-            r, g, b, _ = [int(part.strip()) for part in parts]
-        elif isinstance(rgba, tuple) and len(rgba) == 4:
-            r, g, b, _ = rgba
-        else:
-            raise ValueError(
-                "RGBA must be a string or a tuple of four components.")
-
-        return f'#{r:02X}{g:02X}{b:02X}'
-    except Exception as _:
-        return "#000000"  # Default to black if conversion fails
-
-
-def parse_rgba(rgba_str):
-    """
-    Parses an RGBA string into a list of integers.
-
-    Args:
-        rgba_str (str): A string like "248,208,73,255".
-
-    Returns:
-        list: A list of integers [248, 208, 73, 255].
-    """
-    try:
-        return list(map(int, rgba_str.split(',')))
-    except ValueError:
-        return [0, 0, 0, 255]  # Default to black if parsing fails
-
-
 def load_image(image_path):
     """
     Loads an image from the given path and returns a PIL Image object.
@@ -198,20 +120,6 @@ def load_image_to_tk(pil_image, target_size):
     return ImageTk.PhotoImage(resized_image)
 
 
-def str2bool(v):
-    """
-    Converts a string argument to a boolean value.
-    """
-    if isinstance(v, bool):
-        return v
-    if v.lower() in ('yes', 'true', 't', 'y', '1'):
-        return True
-    elif v.lower() in ('no', 'false', 'f', 'n', '0'):
-        return False
-    else:
-        raise ArgumentTypeError('Boolean value expected.')
-
-
 def find_font_in_windows(font_name='Arial.ttf'):
     fonts_dir = r'C:\\Windows\\Fonts'
     font_path = os.path.join(fonts_dir, font_name)
@@ -320,64 +228,90 @@ def calculate_area(p1, p2, p3):
                      (p2[1] - p1[1]))
 
 
-def filter_close_points(points: List[Tuple[int, int]],
-                        min_distance: float) -> List[Tuple[int, int]]:
+def filter_close_points(points, min_distance: float) -> np.ndarray:
     """
-    Removes points that are closer than min_distance.
-    Always keeps the first, last
+    Removes points that are closer than min_distance to the last kept
+    point. Always keeps the first, last
 
     Args:
-        points (List[Tuple[int, int]]): List of (x, y) points.
+        points: Sequence of (x, y) points or (N, 2) array.
         min_distance (float): Minimum allowable distance between points.
 
     Returns:
-        List[Tuple[int, int]]: Filtered list of points.
+        np.ndarray: Filtered (M, 2) array of points.
     """
-    if len(points) < 2:
-        return points  # Not enough points to filter
-
-    filtered_points = [points[0]]  # Keep the first point
-    last_kept_point = points[0]
-
-    for i in range(1, len(points) - 1):
-        current_point = points[i]
-        dist = point_distance(last_kept_point, current_point)
-        if dist >= min_distance:
-            filtered_points.append(current_point)
-            last_kept_point = current_point
+    points_array = np.asarray(points)
+    num_points = len(points_array)
+    if num_points < 2:
+        return points_array  # Not enough points to filter
+
+    coords = points_array.astype(np.float64, copy=False)
+    segment_lengths = np.hypot(*np.diff(coords, axis=0).T)
+    cumulative = np.concatenate((np.zeros(1), np.cumsum(segment_lengths)))
+    min_distance_sq = min_distance * min_distance
+
+    kept = [0]
+    last_kept = 0
+    # The arc length bounds the chord, so searchsorted on the cumulative
+    # distances skips every point that cannot possibly be far enough;
+    # only the few candidates past that bound are checked exactly
+    index = int(np.searchsorted(cumulative, cumulative[0] + min_distance))
+    while index < num_points - 1:
+        dx = coords[index, 0] - coords[last_kept, 0]
+        dy = coords[index, 1] - coords[last_kept, 1]
+        if dx * dx + dy * dy >= min_distance_sq:
+            kept.append(index)
+            last_kept = index
+            index = int(
+                np.searchsorted(cumulative,
+                                cumulative[last_kept] + min_distance))
+        else:
+            index += 1
 
-    filtered_points.append(points[-1])  # Keep the last point
-    return filtered_points
+    kept.append(num_points - 1)  # Keep the last point
+    return points_array[np.array(kept)]
 
 
-def insert_midpoints(points: List[Tuple[int, int]],
-                     max_distance: float) -> List[Tuple[int, int]]:
+def insert_midpoints(points, max_distance: float) -> np.ndarray:
     """
     Inserts midpoints between consecutive points if the distance between them exceeds max_distance.
     Ensures that points remain in sequential order after midpoint insertion.
 
     Args:
-        points (List[Tuple[int, int]]): List of (x, y) points.
+        points: Sequence of (x, y) points or (N, 2) array.
         max_distance (float): Maximum allowable distance between consecutive points.
 
     Returns:
-        List[Tuple[int, int]]: Refined list of points with inserted midpoints, all as integer coordinates.
+        np.ndarray: Refined (M, 2) array of points with inserted midpoints.
     """
-    points_array = np.array(points)
-    deltas = np.diff(points_array, axis=0)
+    points_array = np.asarray(points)
+    if len(points_array) < 2:
+        return points_array
+
+    coords = points_array.astype(np.float64, copy=False)
+    deltas = np.diff(coords, axis=0)
     distances = np.hypot(deltas[:, 0], deltas[:, 1])
-    num_midpoints = (distances // max_distance).astype(int)
-
-    refined_points = [points[0]]
-    for i in range(len(points_array) - 1):
-        n_mid = num_midpoints[i]
-        if n_mid > 0:
-            t_values = np.linspace(0, 1, n_mid + 2)[1:-1]
-            midpoints = (1 - t_values[:, np.newaxis]) * points_array[
-                i] + t_values[:, np.newaxis] * points_array[i + 1]
-            # Convert midpoints to integer coordinates
-            refined_points.extend(
-                [tuple(map(np.int32, midpoint)) for midpoint in midpoints])
-        refined_points.append(tuple(map(np.int32, points[i + 1])))
-
-    return refined_points
+    num_midpoints = (distances // max_distance).astype(np.int64)
+    if not num_midpoints.any():
+        return points_array
+
+    # Each segment contributes its start point plus its midpoints; the
+    # interpolation parameters for all segments are built in one pass
+    vertices_per_segment = num_midpoints + 1
+    segment_of_vertex = np.repeat(np.arange(len(distances)),
+                                  vertices_per_segment)
+    segment_starts = np.concatenate(
+        (np.zeros(1, dtype=np.int64), np.cumsum(vertices_per_segment)[:-1]))
+    rank_in_segment = np.arange(len(segment_of_vertex)) - np.repeat(
+        segment_starts, vertices_per_segment)
+    t_values = (rank_in_segment /
+                vertices_per_segment[segment_of_vertex])[:, np.newaxis]
+
+    refined = np.empty((len(segment_of_vertex) + 1, 2), dtype=np.float64)
+    refined[:-1] = (1.0 - t_values) * coords[segment_of_vertex] + \
+        t_values * coords[segment_of_vertex + 1]
+    refined[-1] = coords[-1]
+
+    if np.issubdtype(points_array.dtype, np.integer):
+        refined = refined.astype(points_array.dtype)
+    return refined
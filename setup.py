@@ -67,8 +67,11 @@ SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
 MAIN_SCRIPT = os.path.join(SCRIPT_DIR, "dot2dot", "main.py")
 ASSETS_PATH = os.path.join(SCRIPT_DIR, "assets")
 
-# Specify application packages and files
-PACKAGES = ["dot2dot", "dot2dot.gui", "numpy"]
+# Specify application packages and files.
+# cv2 and PIL are imported lazily inside main() since the fast-startup
+# rework, so they are listed explicitly instead of relying on import
+# analysis of the entry point.
+PACKAGES = ["dot2dot", "dot2dot.gui", "numpy", "cv2", "PIL"]
 INCLUDES = []
 EXCLUDES = []
 INCLUDE_FILES = [(ASSETS_PATH, "assets")]